@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Small helpers shared by the benchmark executables. Output is JSON so CI can diff it against a baseline.
+namespace Bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    inline std::int64_t ElapsedNs(Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    // Keeps the optimizer from dropping benchmarked work
+    template <class T>
+    inline void DoNotOptimize(const T &value) {
+        static volatile const void *sink;
+        sink = &value;
+    }
+
+    struct Samples {
+            std::vector<std::int64_t> values;
+
+            void Add(std::int64_t v) {
+                values.push_back(v);
+            }
+
+            double Mean() const {
+                if (values.empty()) {
+                    return 0.0;
+                }
+                double sum = 0.0;
+                for (const auto v: values) {
+                    sum += static_cast<double>(v);
+                }
+                return sum / static_cast<double>(values.size());
+            }
+
+            std::int64_t Percentile(double p) {
+                if (values.empty()) {
+                    return 0;
+                }
+                std::sort(values.begin(), values.end());
+                const auto index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+                return values[index];
+            }
+    };
+
+    // Minimal streaming JSON writer, handles commas and nesting
+    class JsonWriter {
+        public:
+            explicit JsonWriter(std::FILE *a_out)
+                : out(a_out) {}
+
+            void BeginObject(std::string_view key = {}) {
+                Open(key, '{');
+            }
+            void EndObject() {
+                Close('}');
+            }
+            void BeginArray(std::string_view key = {}) {
+                Open(key, '[');
+            }
+            void EndArray() {
+                Close(']');
+            }
+
+            void Value(std::string_view key, double v) {
+                Key(key);
+                std::fprintf(out, "%.3f", v);
+            }
+            void Value(std::string_view key, std::int64_t v) {
+                Key(key);
+                std::fprintf(out, "%lld", static_cast<long long>(v));
+            }
+            void Value(std::string_view key, std::uint64_t v) {
+                Key(key);
+                std::fprintf(out, "%llu", static_cast<unsigned long long>(v));
+            }
+            void Value(std::string_view key, int v) {
+                Value(key, static_cast<std::int64_t>(v));
+            }
+            void Value(std::string_view key, std::string_view v) {
+                Key(key);
+                std::fprintf(out, "\"%.*s\"", static_cast<int>(v.size()), v.data());
+            }
+
+        private:
+            void Key(std::string_view key) {
+                if (needComma) {
+                    std::fputc(',', out);
+                }
+                needComma = true;
+                std::fputc('\n', out);
+                for (int i = 0; i < depth; i++) {
+                    std::fputs("  ", out);
+                }
+                if (!key.empty()) {
+                    std::fprintf(out, "\"%.*s\": ", static_cast<int>(key.size()), key.data());
+                }
+            }
+
+            void Open(std::string_view key, char bracket) {
+                if (depth > 0 || needComma) {
+                    Key(key);
+                }
+                std::fputc(bracket, out);
+                depth++;
+                needComma = false;
+            }
+
+            void Close(char bracket) {
+                depth--;
+                std::fputc('\n', out);
+                for (int i = 0; i < depth; i++) {
+                    std::fputs("  ", out);
+                }
+                std::fputc(bracket, out);
+                needComma = true;
+                if (depth == 0) {
+                    std::fputc('\n', out);
+                }
+            }
+
+            std::FILE *out;
+            int depth = 0;
+            bool needComma = false;
+    };
+
+    // --key value style argument lookup
+    inline std::string_view Arg(int argc, char **argv, std::string_view key, std::string_view fallback = {}) {
+        for (int i = 1; i + 1 < argc; i++) {
+            if (key == argv[i]) {
+                return argv[i + 1];
+            }
+        }
+        return fallback;
+    }
+}  // namespace Bench
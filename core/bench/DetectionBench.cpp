@@ -0,0 +1,791 @@
+#include <cmath>
+#include <map>
+#include <numbers>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "ParkourCore/CountingWorldQuery.h"
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/DetectionCache.h"
+#include "ParkourCore/DetectionJob.h"
+#include "ParkourCore/GrabPrediction.h"
+#include "ParkourCore/HeadingScan.h"
+#include "ParkourCore/QualityTier.h"
+#include "ParkourCore/SceneLibrary.h"
+
+// Runs ParkourCore::GetLedgePoint over the generated scene corpus and a spread of player poses.
+// Reports wall time and raycasts per decision, overall and per ParkourType, as JSON.
+// Exits non-zero if a cached decision differs from a fresh one, tracked heading decisions included.
+//
+//   SkyParkourDetectionBench [--iterations N] [--out file.json]
+
+using namespace ParkourCore;
+
+namespace {
+    struct Decision {
+            SceneLibrary::Case *sceneCase = nullptr;
+            PlayerState player;
+            ScaledThresholds thresholds;
+            std::string name;
+            int ledgeType = ParkourType::NoLedge;
+            std::uint64_t rays = 0;
+    };
+
+    struct TypeStats {
+            Bench::Samples ns;
+            std::uint64_t decisions = 0;
+            std::uint64_t rays = 0;
+            std::uint64_t maxRays = 0;
+    };
+
+    // A few distances from the obstacle and small yaw offsets per scene
+    std::vector<Decision> MakeDecisions(std::vector<SceneLibrary::Case> &corpus) {
+        std::vector<Decision> decisions;
+        for (auto &sceneCase: corpus) {
+            for (const float backOff: {0.0f, 20.0f, 40.0f}) {
+                for (const float yawOffset: {0.0f, 0.15f, -0.15f}) {
+                    Decision decision;
+                    decision.sceneCase = &sceneCase;
+                    decision.player = sceneCase.player;
+                    decision.player.position.y -= backOff;
+                    decision.player.yaw += yawOffset;
+                    decision.thresholds = ScaledThresholds::ForScale(decision.player.scale);
+                    decision.name = sceneCase.name + "@" + std::to_string(static_cast<int>(backOff)) + "/" +
+                                    std::to_string(static_cast<int>(yawOffset * 100.0f));
+                    decisions.push_back(decision);
+                }
+            }
+        }
+        return decisions;
+    }
+
+    struct SearchComparison {
+            std::uint64_t decisions = 0;
+            std::uint64_t baselineRays = 0;
+            std::uint64_t rays = 0;
+            std::uint64_t sweeps = 0;
+            Bench::Samples baselineNs;
+            Bench::Samples ns;
+            std::uint64_t typeMismatches = 0;
+            std::uint64_t pointMismatches = 0;  // Same type, ledge point moved more than a unit
+            std::vector<std::string> mismatchNames;
+    };
+
+    // Every decision once with the default thresholds and once with configure applied, results must agree.
+    // sampleSweeps replaces the scene's exact box sweeps with the default corner rays.
+    template <class F>
+    SearchComparison CompareSearch(const std::vector<Decision> &decisions, F &&configure, bool sampleSweeps = false) {
+        SearchComparison comparison;
+        for (const auto &decision: decisions) {
+            auto &scene = decision.sceneCase->scene;
+            auto thresholds = decision.thresholds;
+            configure(thresholds);
+
+            CountingWorldQuery baselineCounter(scene);
+            const auto baselineStart = Bench::Clock::now();
+            const auto baseline = GetLedgePoint(baselineCounter, decision.player, decision.thresholds, true);
+            comparison.baselineNs.Add(Bench::ElapsedNs(baselineStart));
+            CountingWorldQuery counter(scene);
+            counter.sampleSweeps = sampleSweeps;
+            const auto start = Bench::Clock::now();
+            const auto result = GetLedgePoint(counter, decision.player, thresholds, true);
+            comparison.ns.Add(Bench::ElapsedNs(start));
+
+            comparison.decisions++;
+            comparison.baselineRays += baselineCounter.rays;
+            comparison.rays += counter.rays;
+            comparison.sweeps += counter.sweeps;
+            if (result.ledgeType != baseline.ledgeType) {
+                comparison.typeMismatches++;
+                comparison.mismatchNames.push_back(decision.name);
+            }
+            else if ((result.ledgePoint - baseline.ledgePoint).Length() > 1.0f) {
+                comparison.pointMismatches++;
+                comparison.mismatchNames.push_back(decision.name);
+            }
+        }
+        return comparison;
+    }
+
+    void WriteComparison(Bench::JsonWriter &json, const char *name, const SearchComparison &comparison) {
+        const auto decisions = static_cast<double>(comparison.decisions);
+        json.BeginObject(name);
+        json.Value("decisions", comparison.decisions);
+        json.Value("baseline_rays_per_decision", static_cast<double>(comparison.baselineRays) / decisions);
+        json.Value("rays_per_decision", static_cast<double>(comparison.rays) / decisions);
+        json.Value("ray_reduction", 1.0 - static_cast<double>(comparison.rays) / static_cast<double>(comparison.baselineRays));
+        json.Value("sweeps_per_decision", static_cast<double>(comparison.sweeps) / decisions);
+        json.Value("baseline_ns_mean", comparison.baselineNs.Mean());
+        json.Value("ns_mean", comparison.ns.Mean());
+        json.Value("type_mismatches", comparison.typeMismatches);
+        json.Value("point_mismatches", comparison.pointMismatches);
+        json.BeginArray("mismatched");
+        for (const auto &mismatch: comparison.mismatchNames) {
+            json.Value({}, mismatch);
+        }
+        json.EndArray();
+        json.EndObject();
+    }
+
+    struct HeadingRun {
+            std::uint64_t decisions = 0;
+            std::uint64_t facingFound = 0;  // GetLedgePoint along the turned facing
+            std::uint64_t scanFound = 0;
+            std::uint64_t matchesInput = 0;  // Same type as GetLedgePoint facing the input direction
+            std::uint64_t budgetLimited = 0;
+            std::uint64_t evaluated = 0;
+            std::uint64_t pruned = 0;
+            std::uint64_t casts = 0;
+            std::uint64_t maxCasts = 0;
+
+            // The plugin path: HeadingTracker and the DetectionCache over a few updates walking up with the same input
+            std::uint64_t trackedUpdates = 0;
+            std::uint64_t trackedScans = 0;
+            std::uint64_t trackedCasts = 0;
+            std::uint64_t trackedMismatches = 0;  // Against a fresh GetLedgePoint along the tracked heading
+    };
+
+    // Character turned a quarter away from where the player pushes, like True Directional Movement mid turn
+    HeadingRun RunHeadingScan(const std::vector<Decision> &decisions) {
+        HeadingRun run;
+        for (const auto &decision: decisions) {
+            PlayerState turned = decision.player;
+            turned.yaw += std::numbers::pi_v<float> / 2.0f;
+            const Vec3 inputDir = DirFlatFromYaw(decision.player.yaw);
+
+            const auto facing = GetLedgePoint(decision.sceneCase->scene, turned, decision.thresholds, true);
+            const auto scan = ScanHeadings(decision.sceneCase->scene, turned, decision.thresholds, true, inputDir);
+
+            run.decisions++;
+            run.facingFound += facing.ledgeType != ParkourType::NoLedge;
+            run.scanFound += scan.best.ledgeType != ParkourType::NoLedge;
+            run.matchesInput += scan.best.ledgeType == decision.ledgeType;
+            run.budgetLimited += scan.budgetLimited;
+            run.evaluated += static_cast<std::uint64_t>(scan.evaluated);
+            run.pruned += static_cast<std::uint64_t>(scan.pruned);
+            run.casts += scan.casts;
+            run.maxCasts = std::max<std::uint64_t>(run.maxCasts, scan.casts);
+
+            HeadingTracker tracker;
+            DetectionCache cache;
+            for (int update = 0; update < 8; update++) {
+                PlayerState state = turned;
+                state.position = turned.position - inputDir * (24.0f - 3.0f * static_cast<float>(update));  // 180 units/s at 60 fps
+                std::optional<HeadingScanResult> trackerScan;
+                state.yaw = tracker.Update(decision.sceneCase->scene, state, decision.thresholds, true, inputDir, trackerScan);
+                if (trackerScan && trackerScan->best.ledgeType != ParkourType::NoLedge) {
+                    cache.Remember(decision.sceneCase->scene, state, decision.thresholds, true, trackerScan->best, trackerScan->casts, 0);
+                }
+                const auto tracked = cache.GetLedgePoint(decision.sceneCase->scene, state, decision.thresholds, true, 0);
+                const auto fresh = GetLedgePoint(decision.sceneCase->scene, state, decision.thresholds, true);
+                run.trackedMismatches += tracked.ledgeType != fresh.ledgeType || (tracked.ledgePoint - fresh.ledgePoint).Length() > 1.0f;
+            }
+            run.trackedUpdates += tracker.GetStats().updates;
+            run.trackedScans += tracker.GetStats().scans;
+            run.trackedCasts += tracker.GetStats().scanCasts + cache.GetStats().raysCast;
+        }
+        return run;
+    }
+
+    struct GrabRun {
+            std::uint64_t jumps = 0;
+            std::uint64_t grabbable = 0;        // Per frame detection finds a Grab somewhere along the jump
+            std::uint64_t sampledCaught = 0;    // Detection only on input frames still finds it
+            std::uint64_t predictedCaught = 0;  // The predicted window opens on a frame that really has the Grab
+            std::uint64_t falsePredictions = 0;
+            Bench::Samples sampledLateMs;    // After the first frame with the Grab
+            Bench::Samples predictedLateMs;  // Negative when the predicted window opens too early
+            std::uint64_t frameCasts = 0;
+            std::uint64_t sampledCasts = 0;
+            std::uint64_t predictionCasts = 0;
+            std::uint64_t predictions = 0;
+            std::uint64_t reuses = 0;
+    };
+
+    // Jumps and falls towards walls of every grab height at 60 fps. The body moves with the same model PredictGrab
+    // uses, at frame rate instead of its coarser steps. Ground truth is GetLedgePoint on every frame, the plugin only
+    // looks on input frames (every inputEvery frames). The predictor runs on those same frames and its window is
+    // checked on the first frame at or after MsUntilWindow, like a scheduled callback.
+    GrabRun RunGrabPrediction(int inputEvery) {
+        constexpr int frames = 60;
+        constexpr float frameTime = 1.0f / 60.0f;
+        const auto frameMs = [](int frameCount) { return std::llround(static_cast<double>(frameCount) * 1000.0 / 60.0); };
+
+        GrabRun run;
+        for (const float height: {140.0f, 175.0f, 190.0f, 225.0f, 240.0f, 280.0f}) {
+            auto scene = SceneLibrary::Wall(height);
+            for (const float backOff: {40.0f, 100.0f, 160.0f}) {
+                for (const float jumpSpeed: {0.0f, 250.0f, 400.0f}) {
+                    for (const float runSpeed: {150.0f, 300.0f}) {
+                        // No jump speed is a fall, starting 60 units under the ledge
+                        const float startZ = jumpSpeed == 0.0f ? height - 60.0f : 0.0f;
+
+                        PlayerState player;
+                        player.position = Vec3(0, -backOff, startZ);
+                        player.velocity = Vec3(0, runSpeed, jumpSpeed);
+                        player.isMoving = true;
+                        player.isGroundedOrSliding = false;
+                        player.isMidairAndNotSliding = true;
+                        const auto thresholds = ScaledThresholds::ForScale(player.scale);
+
+                        // Frame positions from the same body model as the prediction
+                        const Vec3 halfExtents(thresholds.clearanceRadius, thresholds.clearanceRadius, thresholds.standingHeight * 0.5f);
+                        const Vec3 bodyCenter(0, 0, thresholds.standingHeight * 0.5f + 1.0f);
+                        std::vector<Vec3> path = {player.position};
+                        std::vector<Vec3> velocities = {player.velocity};
+                        Vec3 velocity = player.velocity;
+                        while (static_cast<int>(path.size()) < frames) {
+                            const Vec3 position = path.back();
+                            const float drop = 0.5f * thresholds.grabGravity * frameTime * frameTime;
+                            const Vec3 next = position + velocity * frameTime - Vec3(0, 0, drop);
+                            velocity.z -= thresholds.grabGravity * frameTime;
+                            const Vec3 move = next - position;
+                            const float length = move.Length();
+                            const Vec3 dir = move * (1.0f / length);
+                            const RayHit hit = scene.SweepBox(position + bodyCenter, halfExtents, dir, length);
+                            if (hit.distance >= length) {
+                                path.push_back(next);
+                                velocities.push_back(velocity);
+                                continue;
+                            }
+                            path.push_back(position + dir * std::max(hit.distance - 0.5f, 0.0f));
+                            if (hit.normal.z > 0.7f) {
+                                break;
+                            }
+                            velocity.x = 0.0f;
+                            velocity.y = 0.0f;
+                            velocities.push_back(velocity);
+                        }
+
+                        std::vector<bool> grab(path.size());
+                        int firstGrab = -1;
+                        for (std::size_t f = 0; f < path.size(); f++) {
+                            PlayerState framePlayer = player;
+                            framePlayer.position = path[f];
+                            CountingWorldQuery counter(scene);
+                            grab[f] = GetLedgePoint(counter, framePlayer, thresholds, true).ledgeType == ParkourType::Grab;
+                            run.frameCasts += counter.rays;
+                            if (f % static_cast<std::size_t>(inputEvery) == 0) {
+                                run.sampledCasts += counter.rays;
+                            }
+                            if (grab[f] && firstGrab < 0) {
+                                firstGrab = static_cast<int>(f);
+                            }
+                        }
+
+                        GrabPredictor predictor;
+                        int sampledFrame = -1;
+                        int predictedFrame = -1;
+                        for (std::size_t f = 0; f < path.size(); f += static_cast<std::size_t>(inputEvery)) {
+                            if (grab[f] && sampledFrame < 0) {
+                                sampledFrame = static_cast<int>(f);
+                            }
+                            if (predictedFrame >= 0) {
+                                continue;
+                            }
+
+                            PlayerState framePlayer = player;
+                            framePlayer.position = path[f];
+                            framePlayer.velocity = velocities[f];
+                            const auto nowMs = static_cast<std::uint64_t>(static_cast<float>(f) * frameTime * 1000.0f);
+                            CountingWorldQuery counter(scene);
+                            predictor.Update(counter, framePlayer, thresholds, nowMs);
+                            run.predictionCasts += counter.rays + counter.sweeps;
+
+                            const auto untilMs = predictor.MsUntilWindow(nowMs);
+                            if (untilMs >= 0) {
+                                const auto fireMs = static_cast<float>(nowMs + static_cast<std::uint64_t>(untilMs));
+                                const auto fireFrame = static_cast<std::size_t>(std::ceil(fireMs / (frameTime * 1000.0f) - 0.001f));
+                                if (fireFrame < path.size()) {
+                                    predictedFrame = static_cast<int>(fireFrame);
+                                }
+                            }
+                        }
+                        run.predictions += predictor.GetStats().predictions;
+                        run.reuses += predictor.GetStats().reuses;
+
+                        run.jumps++;
+                        if (firstGrab < 0) {
+                            run.falsePredictions += predictedFrame >= 0;
+                            continue;
+                        }
+                        run.grabbable++;
+                        if (sampledFrame >= 0) {
+                            run.sampledCaught++;
+                            run.sampledLateMs.Add(frameMs(sampledFrame - firstGrab));
+                        }
+                        if (predictedFrame >= 0) {
+                            run.predictedCaught += grab[static_cast<std::size_t>(predictedFrame)];
+                            run.falsePredictions += !grab[static_cast<std::size_t>(predictedFrame)];
+                            run.predictedLateMs.Add(frameMs(predictedFrame - firstGrab));
+                        }
+                    }
+                }
+            }
+        }
+        return run;
+    }
+
+    struct CacheRun {
+            DetectionCache::Stats stats;
+            std::uint64_t frames = 0;
+            std::uint64_t mismatches = 0;  // Cached type or ledge point differs from a fresh computation
+    };
+
+    // Player idling in front of every scene at 60 fps, one decision per frame. The pose holds still between a sub-unit
+    // shuffle every 20 frames and a slight turn every 30.
+    CacheRun RunIdleFrames(std::vector<SceneLibrary::Case> &corpus, int framesPerCase) {
+        CacheRun run;
+        DetectionCache cache;
+        std::uint32_t cellId = 0;
+        for (auto &sceneCase: corpus) {
+            cache.SetContext(++cellId, sceneCase.player.scale);
+            for (int frame = 0; frame < framesPerCase; frame++) {
+                PlayerState player = sceneCase.player;
+                player.position.x += 0.05f * static_cast<float>(frame / 20 % 7);
+                player.yaw += 0.002f * static_cast<float>(frame / 30 % 5);
+                const auto nowMs = static_cast<std::uint64_t>(frame) * 16;
+
+                const auto thresholds = ScaledThresholds::ForScale(player.scale);
+                const auto cached = cache.GetLedgePoint(sceneCase.scene, player, thresholds, true, nowMs);
+                const auto fresh = GetLedgePoint(sceneCase.scene, player, thresholds, true);
+                run.mismatches += cached.ledgeType != fresh.ledgeType || (cached.ledgePoint - fresh.ledgePoint).Length() > 1.0f;
+                run.frames++;
+            }
+        }
+        run.stats = cache.GetStats();
+        return run;
+    }
+
+    struct SliceRun {
+            DetectionJob::Stats stats;
+            Bench::Samples frames;         // Slices per decision
+            Bench::Samples ns;             // All slices of a decision together
+            std::uint64_t mismatches = 0;  // Type or ledge point differs from one GetLedgePoint
+    };
+
+    // Every decision as a DetectionJob stepped under the budget until it is done
+    SliceRun RunTimeSliced(const std::vector<Decision> &decisions, const SliceBudget &budget) {
+        SliceRun run;
+        DetectionJob job;
+        for (const auto &decision: decisions) {
+            auto &scene = decision.sceneCase->scene;
+            const auto sync = GetLedgePoint(scene, decision.player, decision.thresholds, true);
+
+            const auto start = Bench::Clock::now();
+            job.Start(decision.player, decision.thresholds, true);
+            while (!job.Step(scene, budget)) {
+            }
+            run.ns.Add(Bench::ElapsedNs(start));
+            run.frames.Add(job.FramesSpanned());
+
+            const auto &result = job.Result();
+            run.mismatches += result.ledgeType != sync.ledgeType || (result.ledgePoint - sync.ledgePoint).Length() > 0.0f;
+        }
+        run.stats = job.GetStats();
+        return run;
+    }
+
+    void WriteSliceRun(Bench::JsonWriter &json, const char *name, SliceRun &run) {
+        json.BeginObject(name);
+        json.Value("frames_mean", run.frames.Mean());
+        json.Value("frames_p99", run.frames.Percentile(0.99));
+        json.Value("frames_max", static_cast<std::uint64_t>(run.stats.maxFrames));
+        json.Value("max_slice_casts", static_cast<std::uint64_t>(run.stats.maxSliceCasts));
+        json.Value("split_batches", run.stats.splitBatches);
+        json.Value("ns_mean", run.ns.Mean());
+        json.Value("mismatches", run.mismatches);
+        json.EndObject();
+    }
+
+    struct TierRun {
+            Bench::Samples ns;
+            std::uint64_t rays = 0;
+            std::uint64_t maxRays = 0;
+            std::uint64_t lost = 0;     // The default counts find a ledge, this tier finds none
+            std::uint64_t gained = 0;   // This tier finds one the default counts don't
+            std::uint64_t changed = 0;  // Both find one, of another type
+    };
+
+    TierRun RunTier(const std::vector<Decision> &decisions, int tier, int iterations) {
+        TierRun run;
+        for (const auto &decision: decisions) {
+            const auto thresholds = WithQuality(decision.thresholds, tier);
+            CountingWorldQuery counter(decision.sceneCase->scene);
+            const int type = GetLedgePoint(counter, decision.player, thresholds, true).ledgeType;
+            run.rays += counter.rays;
+            run.maxRays = std::max(run.maxRays, counter.rays);
+            run.lost += type == ParkourType::NoLedge && decision.ledgeType != ParkourType::NoLedge;
+            run.gained += type != ParkourType::NoLedge && decision.ledgeType == ParkourType::NoLedge;
+            run.changed += type != decision.ledgeType && type != ParkourType::NoLedge && decision.ledgeType != ParkourType::NoLedge;
+
+            for (int it = 0; it < iterations; it++) {
+                const auto start = Bench::Clock::now();
+                Bench::DoNotOptimize(GetLedgePoint(decision.sceneCase->scene, decision.player, thresholds, true));
+                run.ns.Add(Bench::ElapsedNs(start));
+            }
+        }
+        return run;
+    }
+
+    void WriteTierRun(Bench::JsonWriter &json, const char *name, const TierRun &run, std::size_t decisions) {
+        json.BeginObject(name);
+        json.Value("rays_per_decision", static_cast<double>(run.rays) / static_cast<double>(decisions));
+        json.Value("rays_max", run.maxRays);
+        json.Value("ns_mean", run.ns.Mean());
+        json.Value("lost", run.lost);
+        json.Value("gained", run.gained);
+        json.Value("changed_type", run.changed);
+        json.EndObject();
+    }
+
+    // Frame times of a session, QualityGovernor's tier at the end of each phase
+    void WriteGovernorTrace(Bench::JsonWriter &json) {
+        struct Phase {
+                const char *name;
+                float meanMs;
+                float jitterMs;
+        };
+        constexpr Phase phases[] = {{"smooth_12ms", 12.0f, 1.0f},
+                                    {"combat_24ms", 24.0f, 3.0f},
+                                    {"between_17ms", 17.0f, 2.5f},
+                                    {"smooth_10ms", 10.0f, 1.0f}};
+        const auto thresholds = baseThresholds;
+
+        QualityGovernor governor;
+        std::uint32_t noise = 1;
+        json.BeginObject("governor");
+        for (const auto &phase: phases) {
+            std::uint64_t changes = 0;
+            for (int frame = 0; frame < 600; frame++) {
+                noise = noise * 1664525u + 1013904223u;
+                const float unit = static_cast<float>(noise >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f;
+                changes += governor.AddFrame(phase.meanMs + unit * phase.jitterMs, thresholds.qualityDownMs, thresholds.qualityUpMs);
+            }
+            json.BeginObject(phase.name);
+            json.Value("tier", governor.Tier());
+            json.Value("changes", changes);
+            json.EndObject();
+        }
+        const auto &stats = governor.GetStats();
+        json.Value("steps_down", stats.stepsDown);
+        json.Value("steps_up", stats.stepsUp);
+        json.Value("frames_low", stats.framesAt[0]);
+        json.Value("frames_medium", stats.framesAt[1]);
+        json.Value("frames_high", stats.framesAt[2]);
+        json.EndObject();
+    }
+
+    struct Walk {
+            CollisionScene *scene = nullptr;
+            std::vector<PlayerState> frames;  // One decision each, 60 fps
+    };
+
+    // Open ground, a corridor too tall to climb with a climbable wall at its end, and a walk up to every corpus
+    // scene that stops in front of the obstacle
+    std::vector<Walk> MakeWalks(std::vector<SceneLibrary::Case> &corpus, CollisionScene &flat, CollisionScene &corridor) {
+        std::vector<Walk> walks;
+
+        Walk open{&flat, {}};
+        for (int frame = 0; frame < 600; frame++) {
+            PlayerState player;
+            player.isMoving = true;
+            const float angle = static_cast<float>(frame) * 0.01f;  // A wide circle, 4 units a frame
+            player.position = Vec3(std::cos(angle) * 400.0f, std::sin(angle) * 400.0f, 0.0f);
+            player.yaw = -angle;  // Facing along the circle, DirFlatFromYaw(yaw) is (sin, cos)
+            open.frames.push_back(player);
+        }
+        walks.push_back(std::move(open));
+
+        Walk hall{&corridor, {}};
+        for (int frame = 0; frame < 600; frame++) {
+            PlayerState player;
+            player.isMoving = frame < 540;
+            const float sway = 10.0f * std::sin(static_cast<float>(frame) * 0.05f);
+            player.position = Vec3(sway, static_cast<float>(std::min(frame, 540)) * 3.0f, 0.0f);
+            player.yaw = 0.05f * std::sin(static_cast<float>(frame) * 0.03f);
+            hall.frames.push_back(player);
+        }
+        walks.push_back(std::move(hall));
+
+        for (auto &sceneCase: corpus) {
+            Walk approach{&sceneCase.scene, {}};
+            for (int frame = 0; frame < 120; frame++) {
+                PlayerState player = sceneCase.player;
+                player.isMoving = frame < 60;
+                player.position.y -= 150.0f - 2.5f * static_cast<float>(std::min(frame, 60));
+                player.position.x += 0.05f * static_cast<float>(frame / 20 % 7);
+                player.yaw += 0.002f * static_cast<float>(frame / 30 % 5);
+                approach.frames.push_back(player);
+            }
+            walks.push_back(std::move(approach));
+        }
+        return walks;
+    }
+
+    struct NegativeRun {
+            NegativeCache::Stats stats;
+            std::uint64_t frames = 0;
+            std::uint64_t rays = 0;            // Everything the cache let through, detection and confirm rays
+            std::uint64_t falseNegatives = 0;  // NoLedge where a fresh computation finds one
+            std::uint64_t mismatches = 0;      // Any other type difference
+    };
+
+    NegativeRun RunNegativeCache(std::vector<Walk> &walks, int mode) {
+        NegativeRun run;
+        DetectionCache cache;
+        std::uint32_t cellId = 0;
+        for (auto &walk: walks) {
+            cache.SetContext(++cellId, 1.0f);
+            for (std::size_t frame = 0; frame < walk.frames.size(); frame++) {
+                const auto &player = walk.frames[frame];
+                auto thresholds = ScaledThresholds::ForScale(player.scale);
+                thresholds.negativeCache = mode;
+                const auto nowMs = static_cast<std::uint64_t>(frame) * 16;
+
+                CountingWorldQuery counter(*walk.scene);
+                const auto cached = cache.GetLedgePoint(counter, player, thresholds, true, nowMs);
+                const auto fresh = GetLedgePoint(*walk.scene, player, thresholds, true);
+                run.rays += counter.rays;
+                if (cached.ledgeType == ParkourType::NoLedge && fresh.ledgeType != ParkourType::NoLedge) {
+                    run.falseNegatives++;
+                }
+                else if (cached.ledgeType != fresh.ledgeType) {
+                    run.mismatches++;
+                }
+                run.frames++;
+            }
+        }
+        run.stats = cache.Negative().GetStats();
+        return run;
+    }
+
+    void WriteNegativeRun(Bench::JsonWriter &json, const char *name, const NegativeRun &run) {
+        json.BeginObject(name);
+        json.Value("rays_per_frame", static_cast<double>(run.rays) / static_cast<double>(run.frames));
+        json.Value("false_negatives", run.falseNegatives);
+        json.Value("other_mismatches", run.mismatches);
+        json.Value("hit_rate", run.stats.HitRate());
+        json.Value("rays_saved", run.stats.raysSaved);
+        json.Value("confirm_rays", run.stats.raysCast);
+        json.Value("confirm_failures", run.stats.confirmFailures);
+        json.Value("stores", run.stats.stores);
+        json.Value("refused", run.stats.refused);
+        json.Value("expired", run.stats.expired);
+        json.Value("evictions", run.stats.evictions);
+        json.EndObject();
+    }
+}  // namespace
+
+int main(int argc, char **argv) {
+    const int iterations = std::stoi(std::string(Bench::Arg(argc, argv, "--iterations", "200")));
+    const std::string outPath{Bench::Arg(argc, argv, "--out")};
+
+    auto corpus = SceneLibrary::StandardCorpus();
+    auto decisions = MakeDecisions(corpus);
+
+    // Deterministic pass: result type and ray count per decision
+    for (auto &decision: decisions) {
+        CountingWorldQuery counter(decision.sceneCase->scene);
+        decision.ledgeType = GetLedgePoint(counter, decision.player, decision.thresholds, true).ledgeType;
+        decision.rays = counter.rays;
+    }
+
+    Bench::Samples allNs;
+    std::map<int, TypeStats> byType;
+    std::uint64_t totalRays = 0;
+
+    const auto benchStart = Bench::Clock::now();
+    for (int it = 0; it < iterations; it++) {
+        for (auto &decision: decisions) {
+            auto &scene = decision.sceneCase->scene;
+
+            const auto start = Bench::Clock::now();
+            const auto result = GetLedgePoint(scene, decision.player, decision.thresholds, true);
+            const auto ns = Bench::ElapsedNs(start);
+            Bench::DoNotOptimize(result);
+
+            allNs.Add(ns);
+            auto &stats = byType[decision.ledgeType];
+            stats.ns.Add(ns);
+            stats.decisions++;
+            stats.rays += decision.rays;
+            stats.maxRays = std::max(stats.maxRays, decision.rays);
+            totalRays += decision.rays;
+        }
+    }
+    const auto benchNs = Bench::ElapsedNs(benchStart);
+
+    std::FILE *out = outPath.empty() ? stdout : std::fopen(outPath.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "can't open %s\n", outPath.c_str());
+        return 1;
+    }
+
+    const auto decisionCount = static_cast<std::uint64_t>(allNs.values.size());
+
+    Bench::JsonWriter json(out);
+    json.BeginObject();
+    json.Value("benchmark", "GetLedgePoint");
+    json.Value("iterations", iterations);
+    json.Value("scenes", static_cast<std::uint64_t>(corpus.size()));
+    json.Value("decisions", decisionCount);
+    json.Value("rays_per_decision", static_cast<double>(totalRays) / static_cast<double>(decisionCount));
+    json.Value("rays_per_ms", static_cast<double>(totalRays) / (static_cast<double>(benchNs) / 1e6));
+    json.BeginObject("ns_per_decision");
+    json.Value("mean", allNs.Mean());
+    json.Value("p50", allNs.Percentile(0.5));
+    json.Value("p99", allNs.Percentile(0.99));
+    json.EndObject();
+
+    json.BeginObject("by_type");
+    for (auto &[type, stats]: byType) {
+        json.BeginObject(ParkourType::Name(type));
+        json.Value("decisions", stats.decisions);
+        json.Value("rays_mean", static_cast<double>(stats.rays) / static_cast<double>(stats.decisions));
+        json.Value("rays_max", stats.maxRays);
+        json.Value("ns_mean", stats.ns.Mean());
+        json.Value("ns_p50", stats.ns.Percentile(0.5));
+        json.Value("ns_p99", stats.ns.Percentile(0.99));
+        json.EndObject();
+    }
+    json.EndObject();
+
+    const auto cacheRun = RunIdleFrames(corpus, 120);
+    json.BeginObject("idle_cache");
+    json.Value("frames", cacheRun.frames);
+    json.Value("hit_rate", cacheRun.stats.HitRate());
+    json.Value("rays_cast", cacheRun.stats.raysCast);
+    json.Value("rays_saved", cacheRun.stats.raysSaved);
+    json.Value("mismatches", cacheRun.mismatches);
+    json.EndObject();
+
+    // Walks through open ground, a corridor and up to every scene, with and without the negative cache
+    auto flat = SceneLibrary::Flat();
+    CollisionScene corridor;
+    SceneLibrary::AddGround(corridor);
+    corridor.AddBox({-160.0f, -100.0f, 0.0f}, {-60.0f, 1700.0f, 400.0f}, CollisionLayer::kStatic);
+    corridor.AddBox({60.0f, -100.0f, 0.0f}, {160.0f, 1700.0f, 400.0f}, CollisionLayer::kStatic);
+    corridor.AddBox({-60.0f, 1660.0f, 0.0f}, {60.0f, 1700.0f, 100.0f}, CollisionLayer::kStatic);
+    corridor.Build();
+    auto walks = MakeWalks(corpus, flat, corridor);
+    const auto negativeOff = RunNegativeCache(walks, NegativeCacheMode::Off);
+    json.BeginObject("negative_cache");
+    json.Value("frames", negativeOff.frames);
+    json.Value("table_bytes", static_cast<std::uint64_t>(sizeof(NegativeCache)));
+    WriteNegativeRun(json, "off", negativeOff);
+    WriteNegativeRun(json, "confirm", RunNegativeCache(walks, NegativeCacheMode::Confirm));
+    json.EndObject();
+
+    // Time sliced detection, how many frames a decision spans and what one frame casts at most
+    Bench::Samples syncNs;
+    std::uint64_t syncMaxCasts = 0;
+    for (const auto &decision: decisions) {
+        const auto start = Bench::Clock::now();
+        Bench::DoNotOptimize(GetLedgePoint(decision.sceneCase->scene, decision.player, decision.thresholds, true));
+        syncNs.Add(Bench::ElapsedNs(start));
+        syncMaxCasts = std::max(syncMaxCasts, decision.rays);
+    }
+    json.BeginObject("time_sliced");
+    json.Value("sync_max_casts", syncMaxCasts);
+    json.Value("sync_ns_mean", syncNs.Mean());
+    for (const int casts: {4, 8, 16}) {
+        auto sliceRun = RunTimeSliced(decisions, SliceBudget{casts, 0});
+        WriteSliceRun(json, ("casts_" + std::to_string(casts)).c_str(), sliceRun);
+    }
+    auto microsecondRun = RunTimeSliced(decisions, SliceBudget{0, 5});
+    WriteSliceRun(json, "microseconds_5", microsecondRun);
+    json.EndObject();
+
+    // Quality tiers against the default counts. High is the default counts through the unrolled loops, it and every
+    // other tier Auto can pick must agree.
+    json.BeginObject("quality_tiers");
+    const auto tierIterations = std::max(1, iterations / 10);
+    std::uint64_t autoTierDifferences = 0;
+    constexpr std::pair<const char *, int> tiers[] = {{"custom", DetectionQuality::Custom},
+                                                      {"high", DetectionQuality::High},
+                                                      {"medium", DetectionQuality::Medium},
+                                                      {"low", DetectionQuality::Low}};
+    for (const auto &[name, tier]: tiers) {
+        const auto tierRun = RunTier(decisions, tier, tierIterations);
+        if (tier >= QualityGovernor::lowestTier) {
+            autoTierDifferences += tierRun.lost + tierRun.gained + tierRun.changed;
+        }
+        WriteTierRun(json, name, tierRun, decisions.size());
+    }
+    WriteGovernorTrace(json);
+    json.EndObject();
+
+    // Alternative probe searches against the linear default
+    WriteComparison(json, "adaptive_forward_search",
+                    CompareSearch(decisions, [](ScaledThresholds &t) { t.ledgeForwardSearch = ProbeSearch::Adaptive; }));
+
+    // Box swept clearance, exact against the scene and sampled with corner rays like a backend without shape casts.
+    // Mismatches are expected where a beam or overhang passes beside the single rays.
+    const auto sweepClearance = [](ScaledThresholds &t) { t.ledgeClearance = ClearanceCheck::Sweep; };
+    WriteComparison(json, "sweep_clearance", CompareSearch(decisions, sweepClearance));
+    WriteComparison(json, "sampled_sweep_clearance", CompareSearch(decisions, sweepClearance, true));
+
+    const auto headingRun = RunHeadingScan(decisions);
+    const auto headingDecisions = static_cast<double>(headingRun.decisions);
+    json.BeginObject("heading_scan");
+    json.Value("headings", baseThresholds.headingCount);
+    json.Value("ray_budget", baseThresholds.headingRayBudget);
+    json.Value("facing_found_rate", static_cast<double>(headingRun.facingFound) / headingDecisions);
+    json.Value("scan_found_rate", static_cast<double>(headingRun.scanFound) / headingDecisions);
+    json.Value("matches_input_rate", static_cast<double>(headingRun.matchesInput) / headingDecisions);
+    json.Value("budget_limited_rate", static_cast<double>(headingRun.budgetLimited) / headingDecisions);
+    json.Value("evaluated_per_scan", static_cast<double>(headingRun.evaluated) / headingDecisions);
+    json.Value("pruned_per_scan", static_cast<double>(headingRun.pruned) / headingDecisions);
+    json.Value("casts_mean", static_cast<double>(headingRun.casts) / headingDecisions);
+    json.Value("casts_max", headingRun.maxCasts);
+    const auto trackedUpdates = static_cast<double>(headingRun.trackedUpdates);
+    json.BeginObject("tracked");
+    json.Value("updates", headingRun.trackedUpdates);
+    json.Value("scans_per_update", static_cast<double>(headingRun.trackedScans) / trackedUpdates);
+    json.Value("casts_per_update", static_cast<double>(headingRun.trackedCasts) / trackedUpdates);
+    json.Value("mismatches", headingRun.trackedMismatches);
+    json.EndObject();
+    json.EndObject();
+
+    const int grabInputEvery = 6;
+    auto grabRun = RunGrabPrediction(grabInputEvery);
+    const auto grabbable = static_cast<double>(grabRun.grabbable);
+    json.BeginObject("grab_prediction");
+    json.Value("jumps", grabRun.jumps);
+    json.Value("grabbable", grabRun.grabbable);
+    json.Value("input_every_frames", grabInputEvery);
+    json.Value("sampled_catch_rate", static_cast<double>(grabRun.sampledCaught) / grabbable);
+    json.Value("sampled_late_ms_mean", grabRun.sampledLateMs.Mean());
+    json.Value("sampled_late_ms_max", grabRun.sampledLateMs.Percentile(1.0));
+    json.Value("predicted_catch_rate", static_cast<double>(grabRun.predictedCaught) / grabbable);
+    json.Value("predicted_late_ms_mean", grabRun.predictedLateMs.Mean());
+    json.Value("predicted_late_ms_min", grabRun.predictedLateMs.Percentile(0.0));
+    json.Value("predicted_late_ms_max", grabRun.predictedLateMs.Percentile(1.0));
+    json.Value("false_predictions", grabRun.falsePredictions);
+    json.Value("every_frame_casts_per_jump", static_cast<double>(grabRun.frameCasts) / static_cast<double>(grabRun.jumps));
+    json.Value("sampled_casts_per_jump", static_cast<double>(grabRun.sampledCasts) / static_cast<double>(grabRun.jumps));
+    json.Value("prediction_casts_per_jump", static_cast<double>(grabRun.predictionCasts) / static_cast<double>(grabRun.jumps));
+    json.Value("reuse_rate", static_cast<double>(grabRun.reuses) / static_cast<double>(grabRun.reuses + grabRun.predictions));
+    json.EndObject();
+
+    // Deterministic per decision results, diffable between algorithm changes
+    json.BeginArray("cases");
+    for (const auto &decision: decisions) {
+        json.BeginObject();
+        json.Value("name", decision.name);
+        json.Value("type", ParkourType::Name(decision.ledgeType));
+        json.Value("rays", decision.rays);
+        json.EndObject();
+    }
+    json.EndArray();
+    json.EndObject();
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return cacheRun.mismatches == 0 && headingRun.trackedMismatches == 0 && autoTierDifferences == 0 ? 0 : 2;
+}
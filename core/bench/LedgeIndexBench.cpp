@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/LedgeIndexBaker.h"
+#include "ParkourCore/SceneLibrary.h"
+
+// Bakes a ledge index for every corpus scene, writes it, maps it back and checks the mapped view against the bake.
+// Then reruns the detection poses and checks that the bake has a ledge wherever live detection finds one.
+// Exits non-zero if a round trip, a rebake or a corrupted file check fails.
+//
+//   SkyParkourLedgeIndexBench [--iterations N] [--dir path] [--out file.json]
+
+using namespace ParkourCore;
+
+namespace {
+    struct Pose {
+            SceneLibrary::Case *sceneCase = nullptr;
+            PlayerState player;
+            ScaledThresholds thresholds;
+            const LedgeIndexView *index = nullptr;
+            std::string name;
+    };
+
+    // Ledges live detection finds and whether the bake has one there. The index is a core tool, detection doesn't
+    // read it, this is how much of what it climbs a bake would know about.
+    struct CoverageRun {
+            std::uint64_t liveLedges = 0;  // StepLow and up, LedgeCheck's types
+            std::uint64_t covered = 0;     // A baked ledge within a sample spacing of the ledge point
+            std::vector<std::string> uncoveredNames;
+    };
+
+    CoverageRun RunCoverage(const std::vector<Pose> &poses) {
+        CoverageRun run;
+        for (const auto &pose: poses) {
+            const auto live = GetLedgePoint(pose.sceneCase->scene, pose.player, pose.thresholds, true);
+            if (live.ledgeType < ParkourType::StepLow || !pose.index) {
+                continue;
+            }
+            run.liveLedges++;
+
+            const float spacing = pose.index->Header().sampleSpacing;
+            bool covered = false;
+            pose.index->ForEachNear(live.ledgePoint, spacing, [&](const BakedLedge &ledge) {
+                covered = covered || (ledge.position - live.ledgePoint).Length() <= spacing;
+            });
+            run.covered += covered;
+            if (!covered) {
+                run.uncoveredNames.push_back(pose.name);
+            }
+        }
+        return run;
+    }
+
+    // Damaged copies that LedgeIndexView::Open has to refuse
+    std::uint64_t CorruptionFailures(const std::vector<std::byte> &bytes) {
+        std::uint64_t failures = 0;
+        std::string error;
+        const auto refuses = [&](std::vector<std::byte> damaged) {
+            LedgeIndex index;
+            failures += index.Adopt(std::move(damaged), error);
+        };
+
+        refuses({bytes.begin(), bytes.end() - 4});  // Truncated
+        auto badMagic = bytes;
+        badMagic[0] = std::byte{0};
+        refuses(badMagic);
+        auto badVersion = bytes;
+        badVersion[offsetof(LedgeIndexHeader, version)] = std::byte{99};
+        refuses(badVersion);
+        auto badTable = bytes;
+        badTable[offsetof(LedgeIndexHeader, cellsX)] = std::byte{0xff};
+        refuses(badTable);
+        return failures;
+    }
+}  // namespace
+
+int main(int argc, char **argv) {
+    const int iterations = std::stoi(std::string(Bench::Arg(argc, argv, "--iterations", "20")));
+    const std::filesystem::path dir{std::string(Bench::Arg(argc, argv, "--dir", ""))};
+    const std::string outPath{Bench::Arg(argc, argv, "--out")};
+
+    const auto indexDir = dir.empty() ? std::filesystem::temp_directory_path() / "SkyParkourLedgeIndex" : dir;
+    std::filesystem::create_directories(indexDir);
+
+    auto corpus = SceneLibrary::StandardCorpus();
+    std::vector<LedgeIndex> indexes(corpus.size());
+
+    LedgeBakeStats totals;
+    Bench::Samples bakeNs;
+    Bench::Samples loadNs;
+    std::uint64_t fileBytes = 0;
+    std::uint64_t roundTripFailures = 0;
+    std::uint64_t rebakeMismatches = 0;
+    std::uint64_t corruptionFailures = 0;
+    std::string error;
+
+    for (std::size_t i = 0; i < corpus.size(); i++) {
+        auto &sceneCase = corpus[i];
+        LedgeBakeSettings settings;
+        settings.cellKey = static_cast<std::uint32_t>(i + 1);
+
+        LedgeBakeStats stats;
+        const auto bakeStart = Bench::Clock::now();
+        const auto bytes = BakeLedgeIndex(sceneCase.scene, settings, &stats);
+        bakeNs.Add(Bench::ElapsedNs(bakeStart));
+        rebakeMismatches += BakeLedgeIndex(sceneCase.scene, settings) != bytes;
+        corruptionFailures += CorruptionFailures(bytes);
+
+        totals.triangles += stats.triangles;
+        totals.walkable += stats.walkable;
+        totals.openEdges += stats.openEdges;
+        totals.samples += stats.samples;
+        totals.ledges += stats.ledges;
+        totals.rejectedWall += stats.rejectedWall;
+        totals.rejectedDrop += stats.rejectedDrop;
+        totals.rejectedBuried += stats.rejectedBuried;
+        fileBytes += bytes.size();
+
+        auto fileName = sceneCase.name;
+        std::replace(fileName.begin(), fileName.end(), '/', '_');
+        const auto path = indexDir / (fileName + ".spli");
+        const auto loadStart = Bench::Clock::now();
+        const bool loaded = WriteLedgeIndex(path, bytes) && indexes[i].LoadFile(path, error);
+        loadNs.Add(Bench::ElapsedNs(loadStart));
+        if (!loaded || !indexes[i].IsMapped()) {
+            std::fprintf(stderr, "%s: %s\n", sceneCase.name.c_str(), error.c_str());
+            roundTripFailures++;
+            continue;
+        }
+
+        const auto &view = indexes[i].View();
+        const auto mapped = std::as_bytes(view.Ledges());
+        const auto baked = std::span(bytes).subspan(view.Header().ledgeOffset, mapped.size());
+        if (view.Header().cellKey != settings.cellKey || !std::equal(mapped.begin(), mapped.end(), baked.begin(), baked.end())) {
+            roundTripFailures++;
+        }
+    }
+
+    // The same poses DetectionBench uses, a few distances back and small yaw offsets per scene
+    std::vector<Pose> poses;
+    for (std::size_t i = 0; i < corpus.size(); i++) {
+        auto &sceneCase = corpus[i];
+        for (const float backOff: {0.0f, 20.0f, 40.0f}) {
+            for (const float yawOffset: {0.0f, 0.15f, -0.15f}) {
+                Pose pose;
+                pose.sceneCase = &sceneCase;
+                pose.player = sceneCase.player;
+                pose.player.position.y -= backOff;
+                pose.player.yaw += yawOffset;
+                pose.thresholds = ScaledThresholds::ForScale(pose.player.scale);
+                pose.index = indexes[i].View().IsOpen() ? &indexes[i].View() : nullptr;
+                pose.name = sceneCase.name + "@" + std::to_string(static_cast<int>(backOff)) + "/" +
+                            std::to_string(static_cast<int>(yawOffset * 100.0f));
+                poses.push_back(pose);
+            }
+        }
+    }
+
+    // Raw lookup cost, every ledge near every pose
+    Bench::Samples lookupNs;
+    std::uint64_t candidates = 0;
+    for (int it = 0; it < iterations; it++) {
+        for (const auto &pose: poses) {
+            if (!pose.index) {
+                continue;
+            }
+            const auto start = Bench::Clock::now();
+            pose.index->ForEachNear(pose.player.position, 100.0f, [&candidates](const BakedLedge &) { candidates++; });
+            lookupNs.Add(Bench::ElapsedNs(start));
+        }
+    }
+
+    const auto coverage = RunCoverage(poses);
+
+    std::FILE *out = outPath.empty() ? stdout : std::fopen(outPath.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "can't open %s\n", outPath.c_str());
+        return 1;
+    }
+
+    Bench::JsonWriter json(out);
+    json.BeginObject();
+    json.Value("benchmark", "LedgeIndex");
+    json.Value("scenes", static_cast<std::uint64_t>(corpus.size()));
+    json.Value("poses", static_cast<std::uint64_t>(poses.size()));
+
+    json.BeginObject("bake");
+    json.Value("triangles", totals.triangles);
+    json.Value("walkable", totals.walkable);
+    json.Value("open_edges", totals.openEdges);
+    json.Value("samples", totals.samples);
+    json.Value("ledges", totals.ledges);
+    json.Value("rejected_wall", totals.rejectedWall);
+    json.Value("rejected_drop", totals.rejectedDrop);
+    json.Value("rejected_buried", totals.rejectedBuried);
+    json.Value("bake_ns_mean", bakeNs.Mean());
+    json.Value("write_and_map_ns_mean", loadNs.Mean());
+    json.Value("file_bytes", fileBytes);
+    json.Value("round_trip_failures", roundTripFailures);
+    json.Value("rebake_mismatches", rebakeMismatches);
+    json.Value("corrupt_files_accepted", corruptionFailures);
+    json.EndObject();
+
+    json.BeginObject("lookup");
+    json.Value("ns_mean", lookupNs.Mean());
+    json.Value("ns_p99", lookupNs.Percentile(0.99));
+    json.Value("candidates_per_lookup", static_cast<double>(candidates) / static_cast<double>(lookupNs.values.size()));
+    json.EndObject();
+
+    json.BeginObject("coverage");
+    json.Value("live_ledges", coverage.liveLedges);
+    json.Value("covered", coverage.covered);
+    json.Value("rate", static_cast<double>(coverage.covered) / static_cast<double>(coverage.liveLedges));
+    json.BeginArray("uncovered");
+    for (const auto &name: coverage.uncoveredNames) {
+        json.Value({}, name);
+    }
+    json.EndArray();
+    json.EndObject();
+    json.EndObject();
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return roundTripFailures == 0 && rebakeMismatches == 0 && corruptionFailures == 0 ? 0 : 2;
+}
@@ -0,0 +1,143 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "ParkourCore/Published.h"
+
+// Hammers ParkourCore::Published with reader threads while one writer republishes as fast as it can.
+// Every published value is internally consistent, a reader that sees a mix of two versions counts as torn.
+// Exits non-zero on any torn read. Run under ASan / TSan to also catch early reclamation.
+//
+//   SkyParkourPublishedStress [--readers N] [--ms duration] [--publishes N] [--out file.json]
+//
+// The writer stops after --ms or --publishes, whichever comes first. 0 publishes is no cap.
+
+namespace {
+    // Shaped like the plugin settings: flags, ints and floats that must change together
+    struct Settings {
+            std::uint64_t generation = 0;
+            bool enabled = true;
+            bool usePresetKey = true;
+            int presetKey = 0;
+            std::int32_t customKey = 0;
+            float delay = 0.0f;
+            float staminaDamage = 20.0f;
+            std::uint64_t check = 0;
+    };
+
+    Settings Make(std::uint64_t generation) {
+        Settings s;
+        s.generation = generation;
+        s.enabled = generation % 2 == 0;
+        s.usePresetKey = generation % 3 == 0;
+        s.presetKey = static_cast<int>(generation % 4);
+        s.customKey = static_cast<std::int32_t>(generation * 7);
+        s.delay = static_cast<float>(generation % 1000) * 0.001f;
+        s.staminaDamage = static_cast<float>(generation % 100);
+        s.check = generation * 0x9E3779B97F4A7C15ull;
+        return s;
+    }
+
+    bool Consistent(const Settings &s) {
+        const auto expected = Make(s.generation);
+        return s.enabled == expected.enabled && s.usePresetKey == expected.usePresetKey && s.presetKey == expected.presetKey &&
+               s.customKey == expected.customKey && s.delay == expected.delay && s.staminaDamage == expected.staminaDamage &&
+               s.check == expected.check;
+    }
+}  // namespace
+
+int main(int argc, char **argv) {
+    const int readerCount = std::stoi(std::string(Bench::Arg(argc, argv, "--readers", "8")));
+    const int durationMs = std::stoi(std::string(Bench::Arg(argc, argv, "--ms", "2000")));
+    const std::uint64_t maxPublishes = std::stoull(std::string(Bench::Arg(argc, argv, "--publishes", "0")));
+    const std::string outPath{Bench::Arg(argc, argv, "--out")};
+
+    ParkourCore::Published<Settings> published(Make(0));
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> reads{0};
+    std::atomic<std::uint64_t> torn{0};
+    std::atomic<std::uint64_t> wentBackwards{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readerCount; r++) {
+        readers.emplace_back([&, r] {
+            std::uint64_t localReads = 0;
+            std::uint64_t lastGeneration = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Alternate between holding a read section and taking a copy, like the plugin does
+                Settings seen;
+                if ((localReads + static_cast<std::uint64_t>(r)) % 2 == 0) {
+                    const auto snapshot = published.Read();
+                    seen = *snapshot;
+                    // Read the live object again inside the section, reclamation must not have touched it
+                    if (!Consistent(*snapshot)) {
+                        torn.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                else {
+                    seen = published.Load();
+                }
+                if (!Consistent(seen)) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (seen.generation < lastGeneration) {
+                    wentBackwards.fetch_add(1, std::memory_order_relaxed);
+                }
+                lastGeneration = seen.generation;
+                localReads++;
+            }
+            reads.fetch_add(localReads, std::memory_order_relaxed);
+        });
+    }
+
+    std::uint64_t publishes = 0;
+    Bench::Samples publishNs;
+    const auto start = Bench::Clock::now();
+    while (Bench::ElapsedNs(start) < static_cast<std::int64_t>(durationMs) * 1000000 && (maxPublishes == 0 || publishes < maxPublishes)) {
+        const auto publishStart = Bench::Clock::now();
+        if (publishes % 2 == 0) {
+            published.Publish(Make(publishes + 1));
+        }
+        else {
+            published.Update([&](Settings &s) { s = Make(publishes + 1); });
+        }
+        publishNs.Add(Bench::ElapsedNs(publishStart));
+        publishes++;
+    }
+    stop.store(true);
+    for (auto &reader: readers) {
+        reader.join();
+    }
+
+    std::FILE *out = outPath.empty() ? stdout : std::fopen(outPath.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "can't open %s\n", outPath.c_str());
+        return 1;
+    }
+
+    Bench::JsonWriter json(out);
+    json.BeginObject();
+    json.Value("benchmark", "PublishedStress");
+    json.Value("readers", readerCount);
+    json.Value("duration_ms", durationMs);
+    json.Value("reads", reads.load());
+    json.Value("publishes", publishes);
+    json.Value("reclaimed", published.Reclaimed());
+    json.Value("retired_pending", static_cast<std::uint64_t>(published.Retired()));
+    json.Value("torn_reads", torn.load());
+    json.Value("generation_went_backwards", wentBackwards.load());
+    json.BeginObject("publish_ns");
+    json.Value("mean", publishNs.Mean());
+    json.Value("p50", publishNs.Percentile(0.5));
+    json.Value("p99", publishNs.Percentile(0.99));
+    json.Value("max", publishNs.Percentile(1.0));
+    json.EndObject();
+    json.EndObject();
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return torn.load() == 0 && wentBackwards.load() == 0 ? 0 : 2;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ParkourCore {
+
+    // Mirror of RE::COL_LAYER, values must stay identical (checked by static_assert on the plugin side).
+    enum class CollisionLayer : std::uint32_t {
+        kUnidentified = 0,
+        kStatic = 1,
+        kAnimStatic = 2,
+        kTransparent = 3,
+        kClutter = 4,
+        kWeapon = 5,
+        kProjectile = 6,
+        kSpell = 7,
+        kBiped = 8,
+        kTrees = 9,
+        kProps = 10,
+        kWater = 11,
+        kTrigger = 12,
+        kTerrain = 13,
+        kTrap = 14,
+        kNonCollidable = 15,
+        kCloudTrap = 16,
+        kGround = 17,
+        kPortal = 18,
+        kDebrisSmall = 19,
+        kDebrisLarge = 20,
+        kAcousticSpace = 21,
+        kActorZone = 22,
+        kProjectileZone = 23,
+        kGasTrap = 24,
+        kShellCasting = 25,
+        kTransparentWall = 26,
+        kInvisibleWall = 27,
+        kTransparentSmallAnim = 28,
+        kClutterLarge = 29,
+        kCharController = 30,
+        kStairHelper = 31,
+        kDeadBip = 32,
+        kBipedNoCC = 33,
+        kAvoidBox = 34,
+        kCollisionBox = 35,
+        kCameraSphere = 36,
+        kDoorDetection = 37,
+        kConeProjectile = 38,
+        kCamera = 39,
+        kItemPicker = 40,
+        kLOS = 41
+    };
+
+    // Layers parkour is allowed to stand on / climb. Anything else hit by a ray counts as an invalid hit.
+    constexpr bool IsParkourSurface(CollisionLayer layer) {
+        switch (layer) {
+            case CollisionLayer::kStatic:
+            case CollisionLayer::kCollisionBox:
+            case CollisionLayer::kTerrain:
+            case CollisionLayer::kGround:
+            case CollisionLayer::kProps:
+            case CollisionLayer::kDoorDetection:
+            case CollisionLayer::kTrees:
+            case CollisionLayer::kClutterLarge:
+            case CollisionLayer::kAnimStatic:
+            case CollisionLayer::kDebrisLarge:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "ParkourCore/RayBatch.h"
+
+namespace ParkourCore {
+
+    struct Triangle {
+            Vec3 a;
+            Vec3 b;
+            Vec3 c;
+            CollisionLayer layer = CollisionLayer::kStatic;
+    };
+
+    // Offline stand-in for bhkWorld::PickObject. Triangles tagged with collision layers, accelerated with a BVH.
+    // Faces are one sided (counter clockwise seen from outside), so like Havok a ray that starts inside a box doesn't report it.
+    // Casting is read only and safe from several threads once Build() has run.
+    //
+    // Scene file format, one shape per line, '#' starts a comment. Layers are RE::COL_LAYER names or numbers:
+    //   box  minX minY minZ  maxX maxY maxZ  layer
+    //   tri  ax ay az  bx by bz  cx cy cz  layer
+    class CollisionScene : public WorldQuery {
+        public:
+            void AddTriangle(const Triangle &tri);
+            void AddBox(const Vec3 &min, const Vec3 &max, CollisionLayer layer);
+            void Clear();
+
+            // Must be called after the last Add and before casting
+            void Build();
+
+            bool LoadFile(const std::filesystem::path &path, std::string &errorOut);
+            bool Parse(const std::string &text, std::string &errorOut);
+            bool SaveFile(const std::filesystem::path &path) const;
+
+            const std::vector<Triangle> &Triangles() const {
+                return triangles;
+            }
+
+            void CastBatch(RayBatch &batch) override;
+            RayHit CastRay(const Vec3 &origin, const Vec3 &dir, float maxDist) override;
+
+            // Exact swept box, faces count from both sides here since the box has volume
+            RayHit SweepBox(const Vec3 &origin, const Vec3 &halfExtents, const Vec3 &dir, float maxDist) override;
+
+        private:
+            struct Node {
+                    Vec3 min;
+                    Vec3 max;
+                    std::uint32_t leftOrFirst = 0;  // Left child index for inner nodes, first triangle for leaves
+                    std::uint32_t count = 0;        // 0 for inner nodes
+            };
+
+            struct Shape {
+                    bool isBox = false;
+                    Vec3 min;
+                    Vec3 max;
+                    CollisionLayer layer = CollisionLayer::kStatic;
+                    Triangle tri;
+            };
+
+            void Subdivide(std::uint32_t nodeIndex);
+            void UpdateBounds(Node &node) const;
+
+            std::vector<Triangle> triangles;
+            std::vector<Vec3> centroids;
+            std::vector<Node> nodes;
+
+            // Source shapes, kept so SaveFile can write boxes back as boxes
+            std::vector<Shape> shapes;
+    };
+}  // namespace ParkourCore
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ParkourCore/RayBatch.h"
+
+namespace ParkourCore {
+
+    // Forwards to another WorldQuery and counts what goes through. Instrumentation for benchmarks and cost reports.
+    class CountingWorldQuery : public WorldQuery {
+        public:
+            explicit CountingWorldQuery(WorldQuery &a_inner)
+                : inner(a_inner) {}
+
+            void CastBatch(RayBatch &batch) override {
+                rays += batch.Size();
+                batches++;
+                inner.CastBatch(batch);
+            }
+
+            RayHit CastRay(const Vec3 &origin, const Vec3 &dir, float maxDist) override {
+                rays++;
+                batches++;
+                return inner.CastRay(origin, dir, maxDist);
+            }
+
+            // With sampleSweeps the inner query only sees the rays of the default corner sampling, and they are counted
+            RayHit SweepBox(const Vec3 &origin, const Vec3 &halfExtents, const Vec3 &dir, float maxDist) override {
+                sweeps++;
+                if (sampleSweeps) {
+                    return WorldQuery::SweepBox(origin, halfExtents, dir, maxDist);
+                }
+                batches++;
+                return inner.SweepBox(origin, halfExtents, dir, maxDist);
+            }
+
+            void Reset() {
+                rays = 0;
+                batches = 0;
+                sweeps = 0;
+            }
+
+            std::uint64_t rays = 0;
+            std::uint64_t batches = 0;
+            std::uint64_t sweeps = 0;
+            bool sampleSweeps = false;
+
+        private:
+            WorldQuery &inner;
+    };
+}  // namespace ParkourCore
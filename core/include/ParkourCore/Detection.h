@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ParkourCore/ParkourTypes.h"
+#include "ParkourCore/PlayerState.h"
+#include "ParkourCore/RayBatch.h"
+#include "ParkourCore/ScaledThresholds.h"
+
+namespace ParkourCore {
+
+    struct DetectionResult {
+            int ledgeType = ParkourType::NoLedge;
+            Vec3 ledgePoint;
+            Vec3 playerDirFlat;
+            Vec3 backwardAdjustment;
+    };
+
+    // Parkour type for a validated ledge point, from its height relative to the player
+    int ClassifyLedge(const PlayerState &player, const ScaledThresholds &thresholds, const Vec3 &ledgePoint);
+
+    // Thresholds must be ScaledThresholds::ForScale(player.scale), the height ranges are already scaled.
+    // FindLedge is LedgeCheck without the classification, the validated ledge point wherever it is in the range.
+    bool FindLedge(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, Vec3 &ledgePoint, const Vec3 &checkDir,
+                   float minLedgeHeight, float maxLedgeHeight);
+    int LedgeCheck(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, Vec3 &ledgePoint,
+                   const Vec3 &checkDir, float minLedgeHeight, float maxLedgeHeight);
+    int VaultCheck(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, Vec3 &ledgePoint,
+                   const Vec3 &checkDir, float vaultLength, float maxElevationIncrease, float minVaultHeight, float maxVaultHeight);
+
+    // Most rays and sweeps one GetLedgePoint can cast with these thresholds, for callers that keep a budget
+    int MaxCastsPerDecision(const ScaledThresholds &thresholds);
+
+    // Last step of GetLedgePoint for a check's result: rejects ledges under water and fills in the positioning
+    DetectionResult MakeDetectionResult(const PlayerState &player, const ScaledThresholds &thresholds, const Vec3 &playerDirFlat,
+                                        int ledgeType, const Vec3 &ledgePoint);
+
+    // Vault first, then climb. Smart parkour skips vaulting while standing still.
+    DetectionResult GetLedgePoint(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, bool smartParkour);
+}  // namespace ParkourCore
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/NegativeCache.h"
+
+namespace ParkourCore {
+
+    struct DetectionCacheConfig {
+            // Catches doors, moving platforms and anything else the key can't see
+            std::uint32_t ttlMs = static_cast<std::uint32_t>(baseThresholds.cacheTtlMs);
+    };
+
+    // Everything a detection result depends on, exactly. Detection is not continuous in the pose: a probe that moves a
+    // hundredth of a unit can cross an edge and land a step further on, so nearby poses don't share a result. A player
+    // standing still keeps the same pose bit for bit, and so do repeated requests within a frame.
+    struct DetectionKey {
+            Vec3 position;
+            float yaw = 0.0f;
+            float waterHeight = 0.0f;
+            float scale = 1.0f;
+            std::uint8_t flags = 0;
+
+            bool operator==(const DetectionKey &) const = default;
+    };
+
+    // Remembers the last few GetLedgePoint results, a hit is the decision detection would make for that pose. Invalidated
+    // on cell or scale change, entries expire after ttlMs. Behind it a NegativeCache remembers NoLedge results over a
+    // wider area, when thresholds.negativeCache turns it on.
+    // Not thread safe, owned by whoever runs detection.
+    class DetectionCache {
+        public:
+            struct Stats {
+                    std::uint64_t lookups = 0;
+                    std::uint64_t hits = 0;
+                    std::uint64_t raysSaved = 0;  // Rays the cached decisions cost when they were computed
+                    std::uint64_t raysCast = 0;
+                    std::uint64_t invalidations = 0;
+
+                    double HitRate() const {
+                        return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+                    }
+            };
+
+            explicit DetectionCache(const DetectionCacheConfig &a_config = {})
+                : config(a_config) {}
+
+            DetectionKey MakeKey(const PlayerState &player, bool smartParkour) const;
+
+            // Drops everything when the cell or scale differs from the last call. Thresholds follow the scale.
+            void SetContext(std::uint32_t cellId, float scale);
+            void Invalidate();
+
+            const DetectionResult *Find(const DetectionKey &key, std::uint64_t nowMs);
+            void Store(const DetectionKey &key, const DetectionResult &result, std::uint64_t rays, std::uint64_t nowMs);
+
+            // Find, then the negative cache. Nothing when detection has to run.
+            std::optional<DetectionResult> Answer(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds,
+                                                  bool smartParkour, std::uint64_t nowMs);
+            // Stores a result detection computed for this player state, and its NoLedge in the negative cache
+            void Remember(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, bool smartParkour,
+                          const DetectionResult &result, std::uint64_t rays, std::uint64_t nowMs);
+
+            // Answer, or run ParkourCore::GetLedgePoint and Remember the result
+            DetectionResult GetLedgePoint(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds,
+                                          bool smartParkour, std::uint64_t nowMs);
+
+            void SetConfig(const DetectionCacheConfig &a_config);
+            const DetectionCacheConfig &Config() const {
+                return config;
+            }
+
+            const Stats &GetStats() const {
+                return stats;
+            }
+            void ResetStats() {
+                stats = {};
+                negative.ResetStats();
+            }
+
+            NegativeCache &Negative() {
+                return negative;
+            }
+            const NegativeCache &Negative() const {
+                return negative;
+            }
+
+        private:
+            static constexpr std::size_t entryCount = 4;
+
+            struct Entry {
+                    DetectionKey key;
+                    DetectionResult result;
+                    std::uint64_t rays = 0;
+                    std::uint64_t storedMs = 0;
+                    bool valid = false;
+            };
+
+            DetectionCacheConfig config;
+            std::array<Entry, entryCount> entries;
+            std::size_t nextSlot = 0;
+            std::uint32_t cell = 0;
+            float contextScale = 0.0f;
+            Stats stats;
+            NegativeCache negative;
+    };
+}  // namespace ParkourCore
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/DetectionSearch.h"
+
+namespace ParkourCore {
+
+    // What one slice of a DetectionJob may spend, 0 for no limit. A batch is split where the cast budget runs out and the
+    // rest goes out first in the next slice, so a slice never makes more casts than the budget. The time budget can go
+    // over by one cast, a slice always gets its first one so a job always finishes.
+    struct SliceBudget {
+            int casts = 0;                   // Rays and sweeps
+            std::uint32_t microseconds = 0;  // Wall time, checked before every cast
+
+            bool Unlimited() const {
+                return casts <= 0 && microseconds == 0;
+            }
+    };
+
+    // GetLedgePoint spread over several calls, a few casts per frame instead of the whole sweep at once. The job walks
+    // the same casts in the same order as GetLedgePoint, one stage per cast, and keeps what the checks have found so far
+    // between slices. A Step carries on from the cast it stopped at, nothing already cast is cast or decided again. The
+    // searches of DetectionSearch.h decide on each result, so the job ends with the decision a single GetLedgePoint
+    // would have made for the world it saw.
+    // The player state is the one from Start, the ledge point is a world position and stays valid while the job runs.
+    // Not thread safe, owned by whoever runs detection.
+    class DetectionJob {
+        public:
+            struct Stats {
+                    std::uint64_t decisions = 0;  // Jobs that finished
+                    std::uint64_t slices = 0;
+                    std::uint64_t forced = 0;     // Finished by Finish after it had started slicing
+                    std::uint64_t abandoned = 0;  // Reset or restarted before finishing
+                    std::uint64_t casts = 0;
+                    std::uint64_t splitBatches = 0;   // Batches the cast budget cut across two slices
+                    std::uint32_t maxFrames = 0;      // Most slices one decision took
+                    std::uint32_t maxSliceCasts = 0;  // Most casts one slice made
+            };
+
+            // Drops a running job
+            void Start(const PlayerState &a_player, const ScaledThresholds &a_thresholds, bool a_smartParkour);
+
+            // One slice. True once the job is done and Result() holds the decision.
+            bool Step(WorldQuery &world, const SliceBudget &budget);
+
+            // Whatever is left in one go, for when the decision is needed now
+            const DetectionResult &Finish(WorldQuery &world);
+
+            void Reset();
+
+            bool Running() const {
+                return state == State::Running;
+            }
+            bool Done() const {
+                return state == State::Done;
+            }
+
+            const DetectionResult &Result() const {
+                return result;
+            }
+            const PlayerState &Player() const {
+                return player;
+            }
+            bool SmartParkour() const {
+                return smartParkour;
+            }
+
+            // Slices the decision took, 1 when it fit in one
+            std::uint32_t FramesSpanned() const {
+                return frames;
+            }
+            // Casts the decision cost
+            std::uint64_t Casts() const {
+                return casts;
+            }
+
+            const Stats &GetStats() const {
+                return stats;
+            }
+            void ResetStats() {
+                stats = {};
+            }
+
+        private:
+            enum class State { Idle, Running, Done };
+
+            // The cast each stage waits for, in GetLedgePoint's order
+            enum class Stage {
+                VaultForward,
+                VaultBackward,
+                VaultDown,
+                LedgeUp,
+                ProbeForward,
+                ProbeDown,
+                ProbeClearance,
+                AdaptiveForward,
+                AdaptiveFace,
+                AdaptiveDown,
+                AdaptiveClearance,
+                Headroom,
+                Done
+            };
+
+            // Where ForwardSearch::Adaptive is between down rays
+            enum class AdaptivePhase { First, Last, Scan, Bisect, Validate };
+
+            class Slice;
+
+            ForwardSearch Forward(WorldQuery &world) const;
+            VaultSearch Vault(WorldQuery &world) const;
+
+            void Request(Stage next, const Vec3 &origin, const Vec3 &dir, float maxDist);
+            void RequestSweep(Stage next, const Vec3 &origin, const Vec3 &halfExtents, const Vec3 &dir, float maxDist);
+            void RequestClearance(Stage next, const ForwardSearch &search, float fwdRayDist);
+            void CastPending(WorldQuery &world, Slice &slice, std::size_t room);
+
+            void Advance(WorldQuery &world);
+            void BeginLedge();
+            void BeginForwardSearch(WorldQuery &world);
+            void BeginProbe(WorldQuery &world, int i);
+            void ContinueAdaptive(WorldQuery &world);
+            bool NeedCandidate(const ForwardSearch &search, int i);
+            void BeginHeadroom();
+            void Decide(int ledgeType);
+
+            PlayerState player;
+            ScaledThresholds thresholds;
+            bool smartParkour = false;
+            Vec3 checkDir;
+
+            // The cast the current stage waits for, a single ray, a sweep or a batch cast up to pendingCast so far
+            RayBatch pending;
+            std::size_t pendingCast = 0;
+            bool pendingSingle = false;
+            bool pendingSweep = false;
+            Vec3 pendingHalfExtents;
+
+            Stage stage = Stage::Done;
+            Vec3 ledgePoint;
+            Vec3 fwdRayStart;  // LedgeCheck's forward rays, from under the up ray's end
+
+            // Linear probes
+            int probe = 0;
+            int probeEnd = 0;
+            float probeFwdDist = 0.0f;
+
+            // Adaptive
+            AdaptivePhase adaptivePhase = AdaptivePhase::First;
+            std::array<ForwardSearch::Candidate, ForwardSearch::maxIterations> candidates;
+            int adaptiveLast = 0;
+            int adaptiveFirst = 0;
+            int notOnTop = -1;
+            int edge = 0;
+            int adaptiveProbe = 0;  // The candidate a down or clearance cast is for
+
+            DetectionResult result;
+            State state = State::Idle;
+            std::uint32_t frames = 0;
+            std::uint64_t casts = 0;
+            Stats stats;
+    };
+}  // namespace ParkourCore
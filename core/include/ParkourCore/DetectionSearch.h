@@ -0,0 +1,291 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "ParkourCore/ParkourTypes.h"
+#include "ParkourCore/RayBatch.h"
+#include "ParkourCore/ScaledThresholds.h"
+
+// The probe searches of LedgeCheck and VaultCheck. GetLedgePoint runs them through, DetectionJob casts their rays a
+// few at a time and asks them the same questions about each result.
+namespace ParkourCore {
+
+    // LedgeCheck forward search. Probe i reaches forwardStep * i from fwdRayStart, a down ray from its end
+    // finds the candidate ledge point, the first candidate that validates wins.
+    struct ForwardSearch {
+            WorldQuery &world;
+            const ScaledThresholds &thresholds;
+            Vec3 playerPos;
+            Vec3 fwdRayStart;
+            Vec3 checkDir;
+            float downRayLength;
+            float minLedgeHeight;
+            float maxLedgeHeight;
+
+            static constexpr int maxIterations = 64;  // Tuning limit of ledgeForwardIterations
+
+            struct Candidate {
+                    bool probed = false;
+                    RayHit downHit;
+                    Vec3 point;
+            };
+
+            float ProbeDistance(int i) const {
+                return thresholds.ledgeForwardStep * static_cast<float>(i);
+            }
+
+            Vec3 DownRayStart(float fwdRayDist) const {
+                return fwdRayStart + checkDir * fwdRayDist;
+            }
+
+            RayHit CastDown(float fwdRayDist, Vec3 &point) const {
+                const Vec3 downRayDir(0, 0, -1);
+                const Vec3 downRayStart = DownRayStart(fwdRayDist);
+                const RayHit downHit = world.CastRay(downRayStart, downRayDir, downRayLength);
+                point = downRayStart + downRayDir * downHit.distance;
+                return downHit;
+            }
+
+            // Height band and flatness of a candidate
+            bool InBand(const RayHit &downHit, const Vec3 &point) const {
+                return point.z >= playerPos.z + minLedgeHeight && point.z <= playerPos.z + maxLedgeHeight && downHit.distance >= 10 &&
+                       downHit.normal.z >= thresholds.minLedgeFlatness;
+            }
+
+            Vec3 ClearanceStart(float fwdRayDist) const {
+                return fwdRayStart + checkDir * (fwdRayDist - 2) + Vec3(0, 0, 5);
+            }
+
+            RayHit CastClearance(float fwdRayDist) const {
+                const float maxObstructionDistance = thresholds.ledgeObstructionDist;
+                if (thresholds.ledgeClearance == ClearanceCheck::Sweep) {
+                    const Vec3 halfExtents(thresholds.clearanceRadius, thresholds.clearanceRadius, 0);
+                    return world.SweepBox(ClearanceStart(fwdRayDist), halfExtents, checkDir, maxObstructionDistance);
+                }
+                return world.CastRay(ClearanceStart(fwdRayDist), checkDir, maxObstructionDistance);
+            }
+
+            // Free space behind the edge for the clearance cast's distance
+            bool Clear(float clearanceDist) const {
+                const float maxObstructionDistance = thresholds.ledgeObstructionDist;
+                if (thresholds.ledgeClearance == ClearanceCheck::Sweep) {
+                    // A box that starts overlapping something is blocked too, a ray can't start inside geometry
+                    return !(clearanceDist >= 0 && clearanceDist < maxObstructionDistance);
+                }
+                return !(clearanceDist > 0 && clearanceDist < maxObstructionDistance);
+            }
+
+            // Height band, flatness, then free space behind the edge
+            bool Validate(float fwdRayDist, const RayHit &downHit, const Vec3 &point) const {
+                return InBand(downHit, point) && Clear(CastClearance(fwdRayDist).distance);
+            }
+
+            bool Probe(int i, Vec3 &ledgePoint) const {
+                const float fwdCheckDist = ProbeDistance(i);
+                const float fwdRayDist = world.CastRay(fwdRayStart, checkDir, fwdCheckDist).distance;
+                if (fwdRayDist < fwdCheckDist) {
+                    return false;
+                }
+
+                const RayHit downHit = CastDown(fwdRayDist, ledgePoint);
+                return Validate(fwdRayDist, downHit, ledgePoint);
+            }
+
+            // Every probe in order, each forward ray restarting from the origin
+            bool Linear(Vec3 &ledgePoint) const {
+                for (int i = 0; i < thresholds.ledgeForwardIterations; i++) {
+                    if (Probe(i, ledgePoint)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Linear with a quality tier's probe count, unrolled. || stops at the first probe that validates.
+            template <int Iterations>
+            bool LinearUnrolled(Vec3 &ledgePoint) const {
+                return [&]<int... I>(std::integer_sequence<int, I...>) {
+                    return (Probe(I, ledgePoint) || ...);
+                }(std::make_integer_sequence<int, Iterations>{});
+            }
+
+            // The forward probes share origin and direction, so one ray to the far end shows which of them are clear.
+            // A second ray just under the ledge band finds the face of whatever could hold a ledge, down rays start
+            // there, and bisect towards the far end when the face slants away. Same result as Linear when the first
+            // candidate on top follows the face, which holds for walls, fences, steps and slopes. Without a face
+            // every probe still gets its down ray, a floating bar can sit between any two of them.
+            bool Adaptive(Vec3 &ledgePoint) const {
+                const int iterations = std::min(thresholds.ledgeForwardIterations, maxIterations);
+                const float reach = ProbeDistance(iterations - 1);
+
+                const float fwdHitDist = world.CastRay(fwdRayStart, checkDir, reach).distance;
+                if (fwdHitDist < 0) {
+                    return Linear(ledgePoint);  // Non parkour layer, distance unknown
+                }
+                int last = iterations - 1;
+                while (last > 0 && ProbeDistance(last) > fwdHitDist) {
+                    last--;
+                }
+
+                Vec3 lowRayStart = fwdRayStart;
+                lowRayStart.z = playerPos.z + minLedgeHeight - 1;
+                const float faceDist = world.CastRay(lowRayStart, checkDir, reach).distance;
+                if (faceDist < 0) {
+                    return Linear(ledgePoint);
+                }
+
+                std::array<Candidate, maxIterations> candidates;
+                const auto probe = [&](int i) -> const Candidate & {
+                    auto &candidate = candidates[i];
+                    if (!candidate.probed) {
+                        candidate.downHit = CastDown(ProbeDistance(i), candidate.point);
+                        candidate.probed = true;
+                    }
+                    return candidate;
+                };
+                const auto onTop = [&](int i) { return probe(i).point.z >= playerPos.z + minLedgeHeight; };
+
+                // Bisection keeps notOnTop < edge, candidates up to notOnTop are below the band
+                int notOnTop = -1;
+                int edge = last;
+                if (faceDist < reach) {
+                    int first = 0;
+                    while (first < last && ProbeDistance(first) < faceDist) {
+                        first++;
+                    }
+                    if (!onTop(first)) {
+                        if (first == last || !onTop(last)) {
+                            return false;
+                        }
+                        notOnTop = first;
+                    }
+                    else {
+                        edge = first;
+                        notOnTop = first - 1;
+                    }
+                }
+                else {
+                    // No face, anything on top floats (rails, bars on posts) and may sit between any two probes.
+                    // Down rays at every probe, still without the forward rays Linear repeats.
+                    while (notOnTop < last && !onTop(notOnTop + 1)) {
+                        notOnTop++;
+                    }
+                    if (notOnTop == last) {
+                        return false;  // Open ground
+                    }
+                    edge = notOnTop + 1;
+                }
+
+                while (edge - notOnTop > 1) {
+                    const int mid = notOnTop + (edge - notOnTop) / 2;
+                    if (onTop(mid)) {
+                        edge = mid;
+                    }
+                    else {
+                        notOnTop = mid;
+                    }
+                }
+
+                for (int i = edge; i <= last; i++) {
+                    const auto &candidate = probe(i);
+                    if (Validate(ProbeDistance(i), candidate.downHit, candidate.point)) {
+                        ledgePoint = candidate.point;
+                        return true;
+                    }
+                }
+                return false;
+            }
+    };
+
+    // VaultCheck down samples. Sample i is a down ray from the head height forward ray at vaultDownStep * i,
+    // folded in order: the highest sample inside the band is the obstacle top, a later sample below it the landing.
+    struct VaultSearch {
+            WorldQuery &world;
+            const ScaledThresholds &thresholds;
+            Vec3 playerPos;
+            Vec3 checkDir;
+            float startZ;
+            float minVaultHeight;
+            float maxVaultHeight;
+            float maxElevationIncrease;
+
+            bool foundVaulter = false;
+            float foundVaultHeight = -10000.0f;
+            bool foundLanding = false;
+            float foundLandingHeight = 10000.0f;
+
+            int Iterations() const {
+                return std::min(thresholds.vaultDownIterations, static_cast<int>(RayBatch::kCapacity));
+            }
+
+            Vec3 SampleOrigin(int i) const {
+                Vec3 origin = playerPos + checkDir * (static_cast<float>(i) * thresholds.vaultDownStep);
+                origin.z = startZ;
+                return origin;
+            }
+
+            float DownLength() const {
+                return thresholds.vaultHeadHeight + 100.0f;
+            }
+
+            float HitHeight(float downRayDist) const {
+                return (startZ - downRayDist) - playerPos.z;
+            }
+
+            // False when the sample is too high to vault
+            bool Fold(const Vec3 &origin, float downRayDist, Vec3 &ledgePoint) {
+                const float hitHeight = HitHeight(downRayDist);
+
+                // Check hit height for vaultable surfaces
+                if (hitHeight > maxVaultHeight) {
+                    return false;  // Too high to vault
+                }
+                else if (hitHeight > minVaultHeight && hitHeight < maxVaultHeight) {
+                    if (hitHeight >= foundVaultHeight) {
+                        foundVaultHeight = hitHeight;
+                        foundLanding = false;
+                    }
+                    ledgePoint = origin + Vec3(0, 0, -1) * downRayDist;
+                    foundVaulter = true;
+                }
+                else if (foundVaulter && hitHeight < minVaultHeight) {
+                    foundLandingHeight = std::min(hitHeight, foundLandingHeight);
+                    foundLanding = true;
+                }
+                return true;
+            }
+
+            bool Confirmed() const {
+                return foundVaulter && foundLanding && foundLandingHeight < maxElevationIncrease;
+            }
+
+            // Every sample, independent of each other so they go out as one batch
+            bool Linear(Vec3 &ledgePoint) {
+                RayBatch downBatch;
+                for (int i = 0; i < Iterations(); i++) {
+                    downBatch.Add(SampleOrigin(i), Vec3(0, 0, -1), DownLength());
+                }
+                world.CastBatch(downBatch);
+
+                for (std::size_t i = 0; i < downBatch.Size(); i++) {
+                    if (!Fold(downBatch.Origin(i), downBatch.results[i].distance, ledgePoint)) {
+                        return false;
+                    }
+                }
+                return Confirmed();
+            }
+
+            // Linear with a quality tier's sample count, unrolled. && stops at the first sample too high to vault.
+            template <int Iterations>
+            bool LinearUnrolled(Vec3 &ledgePoint) {
+                return [&]<int... I>(std::integer_sequence<int, I...>) {
+                    RayBatch downBatch;
+                    (downBatch.Add(SampleOrigin(I), Vec3(0, 0, -1), DownLength()), ...);
+                    world.CastBatch(downBatch);
+                    return (Fold(downBatch.Origin(I), downBatch.results[I].distance, ledgePoint) && ...) && Confirmed();
+                }(std::make_integer_sequence<int, Iterations>{});
+            }
+    };
+}  // namespace ParkourCore
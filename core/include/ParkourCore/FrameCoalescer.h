@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ParkourCore {
+
+    // Turns any number of update requests into a single pending task. The owner schedules the task only when
+    // Request() returns true, and the task calls BeginRun() before doing the work, so requests that arrive
+    // while it runs schedule the next one. Safe to call from any thread.
+    class FrameCoalescer {
+        public:
+            // True if no task was pending and the caller must schedule one
+            bool Request() {
+                requested.fetch_add(1, std::memory_order_relaxed);
+                return !pending.exchange(true, std::memory_order_acq_rel);
+            }
+
+            void BeginRun() {
+                pending.store(false, std::memory_order_release);
+                executed.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            std::uint64_t Requested() const {
+                return requested.load(std::memory_order_relaxed);
+            }
+            std::uint64_t Executed() const {
+                return executed.load(std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<bool> pending{false};
+            std::atomic<std::uint64_t> requested{0};
+            std::atomic<std::uint64_t> executed{0};
+    };
+}  // namespace ParkourCore
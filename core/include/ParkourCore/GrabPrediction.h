@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "ParkourCore/Detection.h"
+
+namespace ParkourCore {
+
+    inline constexpr int maxGrabPathSteps = 32;
+    inline constexpr float grabPredictionStep = 1.0f / 30.0f;  // Seconds between path samples
+
+    struct PredictedGrab {
+            DetectionResult result;      // Grab as seen from the window start, NoLedge when the path reaches none
+            float timeToContact = 0.0f;  // Seconds from the prediction until the grab window opens
+            float windowEnd = 0.0f;      // Seconds until it closes again
+
+            // Feet positions every grabPredictionStep, the path ends early where the body lands or gets stuck
+            std::array<Vec3, maxGrabPathSteps + 1> path;
+            int pathSteps = 0;
+
+            bool HasGrab() const {
+                return result.ledgeType != ParkourType::NoLedge;
+            }
+
+            // Interpolated, held at the last sample past the end
+            Vec3 PathPosition(float seconds) const;
+    };
+
+    // Midair grab ahead of time. Velocity and gravity are integrated over thresholds.grabHorizon, a body sized box is
+    // swept along each step. The first wall it hits stops the horizontal motion, the player slides down the wall from
+    // there. One FindLedge from the contact point (or the path end) looks for a ledge in reach of the whole path.
+    // The window is where the ledge is in the same range an ordinary detection at that point would grab it from:
+    // climbMinHeight to grabMaxHeight above the feet, and ahead within the forward probes' reach.
+    PredictedGrab PredictGrab(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds);
+
+    // Keeps one prediction for the whole jump. Not thread safe, owned by whoever runs detection.
+    class GrabPredictor {
+        public:
+            struct Stats {
+                    std::uint64_t predictions = 0;
+                    std::uint64_t reuses = 0;
+                    std::uint64_t grabsPredicted = 0;
+            };
+
+            // Reuses the last prediction while the player is still midair and within grabPathTolerance of its path
+            const PredictedGrab &Update(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds,
+                                        std::uint64_t nowMs);
+
+            // The predicted grab while nowMs is inside its window, null otherwise
+            const DetectionResult *Due(std::uint64_t nowMs) const;
+
+            // Until the window opens, 0 inside it, -1 without a grab ahead
+            std::int64_t MsUntilWindow(std::uint64_t nowMs) const;
+
+            void Reset();
+
+            const Stats &GetStats() const {
+                return stats;
+            }
+
+        private:
+            float Elapsed(std::uint64_t nowMs) const;
+
+            PredictedGrab prediction;
+            std::uint64_t predictedAtMs = 0;
+            bool valid = false;
+            Stats stats;
+    };
+}  // namespace ParkourCore
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "ParkourCore/Detection.h"
+
+namespace ParkourCore {
+
+    struct HeadingScanResult {
+            DetectionResult best;
+            float yaw = 0.0f;            // Best's heading, the input yaw when nothing was found
+            float angle = 0.0f;          // Between best's heading and the input direction
+            std::uint32_t casts = 0;     // Rays and sweeps, the reach batch included
+            int evaluated = 0;           // Headings that ran the full vault and ledge checks
+            int pruned = 0;              // Skipped, their angle alone already scores worse than the best
+            bool budgetLimited = false;  // Stopped with headings left because the next one might not fit
+    };
+
+    // GetLedgePoint around the player instead of only along the facing, for movement that doesn't turn the character
+    // first. thresholds.headingCount headings evenly spaced from inputDir (the facing when inputDir is zero).
+    // One batch of two short forward rays per heading finds the headings with something in reach, those are checked
+    // first, each group from the smallest angle to inputDir outwards. A found ledge scores
+    //   angle to inputDir + headingDistanceWeight * horizontal distance
+    // and the lowest score wins. Headings whose angle alone can't beat the best are not checked, and no heading starts
+    // unless MaxCastsPerDecision still fits into headingRayBudget, so a scan never goes over it.
+    HeadingScanResult ScanHeadings(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, bool smartParkour,
+                                   const Vec3 &inputDir);
+
+    // Scans when the movement input changes (a new sector of the headingCount around the circle, or starting and
+    // stopping), when the player is more than ledgeForwardStep from where the last scan ran, and when the ledge it found
+    // is out of reach. In between detection keeps looking along the input turned by the offset the last scan picked, an
+    // ordinary GetLedgePoint the DetectionCache and DetectionJob take. Not thread safe, owned by whoever runs detection.
+    class HeadingTracker {
+        public:
+            struct Stats {
+                    std::uint64_t updates = 0;
+                    std::uint64_t scans = 0;
+                    std::uint64_t scanCasts = 0;
+            };
+
+            // Yaw to run detection along. scan holds the scan when this update ran one: a found best is GetLedgePoint for
+            // the player turned to the returned yaw, bit for bit.
+            float Update(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, bool smartParkour,
+                         const Vec3 &inputDir, std::optional<HeadingScanResult> &scan);
+
+            void Reset();
+
+            const Stats &GetStats() const {
+                return stats;
+            }
+
+        private:
+            int sector = 0;
+            bool moving = false;
+            float offset = 0.0f;  // Picked heading from the input yaw
+            Vec3 scanPosition;
+            bool hasLedge = false;
+            Vec3 ledgePoint;  // The scan's best
+            bool valid = false;
+            Stats stats;
+    };
+}  // namespace ParkourCore
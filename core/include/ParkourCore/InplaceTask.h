@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ParkourCore {
+
+    // Move-only void() callable stored inline. Replaces std::function for queued tasks: no heap allocation,
+    // captures that don't fit are a compile error instead of a silent allocation.
+    template <std::size_t Capacity>
+    class InplaceTask {
+        public:
+            InplaceTask() = default;
+
+            template <class F>
+                requires(!std::is_same_v<std::remove_cvref_t<F>, InplaceTask> && std::is_invocable_v<std::remove_cvref_t<F> &>)
+            InplaceTask(F &&f) {
+                using Fn = std::remove_cvref_t<F>;
+                static_assert(sizeof(Fn) <= Capacity, "Task capture too large for InplaceTask");
+                static_assert(alignof(Fn) <= alignof(std::max_align_t), "Task capture over-aligned");
+                static_assert(std::is_nothrow_move_constructible_v<Fn>, "Task capture must be nothrow movable");
+
+                ::new (static_cast<void *>(storage)) Fn(std::forward<F>(f));
+                ops = &OpsFor<Fn>;
+            }
+
+            InplaceTask(InplaceTask &&other) noexcept {
+                MoveFrom(other);
+            }
+
+            InplaceTask &operator=(InplaceTask &&other) noexcept {
+                if (this != &other) {
+                    Reset();
+                    MoveFrom(other);
+                }
+                return *this;
+            }
+
+            InplaceTask(const InplaceTask &) = delete;
+            InplaceTask &operator=(const InplaceTask &) = delete;
+
+            ~InplaceTask() {
+                Reset();
+            }
+
+            void operator()() {
+                ops->invoke(storage);
+            }
+
+            explicit operator bool() const {
+                return ops != nullptr;
+            }
+
+            void Reset() {
+                if (ops) {
+                    ops->destroy(storage);
+                    ops = nullptr;
+                }
+            }
+
+        private:
+            struct Ops {
+                    void (*invoke)(void *);
+                    void (*move)(void *dst, void *src);
+                    void (*destroy)(void *);
+            };
+
+            template <class Fn>
+            static constexpr Ops OpsFor = {
+                [](void *self) { (*static_cast<Fn *>(self))(); },
+                [](void *dst, void *src) {
+                    ::new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+                    static_cast<Fn *>(src)->~Fn();
+                },
+                [](void *self) { static_cast<Fn *>(self)->~Fn(); }};
+
+            void MoveFrom(InplaceTask &other) {
+                if (other.ops) {
+                    other.ops->move(storage, other.storage);
+                    ops = other.ops;
+                    other.ops = nullptr;
+                }
+            }
+
+            alignas(std::max_align_t) std::byte storage[Capacity];
+            const Ops *ops = nullptr;
+    };
+}  // namespace ParkourCore
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ParkourCore/CollisionLayer.h"
+#include "ParkourCore/MappedFile.h"
+#include "ParkourCore/Math.h"
+
+namespace ParkourCore {
+
+    // Ledge index file, little endian, every section 4 byte aligned so a mapped file is read in place:
+    //   LedgeIndexHeader
+    //   cellsX * cellsY + 1 uint32 first ledge per grid cell, the last one is ledgeCount
+    //   ledgeCount BakedLedge, grouped by grid cell, row by row (y outer, x inner)
+    inline constexpr std::uint32_t ledgeIndexMagic = 0x494c5053;  // "SPLI"
+    inline constexpr std::uint32_t ledgeIndexVersion = 1;
+
+    struct LedgeIndexHeader {
+            std::uint32_t magic = ledgeIndexMagic;
+            std::uint32_t version = ledgeIndexVersion;
+            std::uint32_t headerSize = 0;
+            std::uint32_t cellKey = 0;   // Game cell the ledges belong to, the cell's form ID in game
+            float originX = 0.0f;        // Corner of grid cell 0, 0
+            float originY = 0.0f;
+            float gridSize = 0.0f;       // Side of a grid cell
+            float sampleSpacing = 0.0f;  // Between ledges along one edge
+            std::uint32_t cellsX = 0;
+            std::uint32_t cellsY = 0;
+            std::uint32_t ledgeCount = 0;
+            std::uint32_t cellTableOffset = 0;  // Bytes from the start of the file
+            std::uint32_t ledgeOffset = 0;
+            std::uint32_t fileSize = 0;
+    };
+
+    // One sample of a walkable top edge
+    struct BakedLedge {
+            Vec3 position;           // On the edge
+            float normalX = 0.0f;    // Flat, pointing off the top towards the drop
+            float normalY = 0.0f;
+            float height = 0.0f;     // Edge above the floor in front of it
+            float clearance = 0.0f;  // Free space above the top, capped at the bake's clearance probe
+            CollisionLayer layer = CollisionLayer::kStatic;
+    };
+
+    static_assert(std::is_trivially_copyable_v<LedgeIndexHeader> && sizeof(LedgeIndexHeader) == 56);
+    static_assert(std::is_trivially_copyable_v<BakedLedge> && sizeof(BakedLedge) == 32);
+
+    // Read only view of ledge index bytes, doesn't own them. Open checks the header and every offset once, lookups
+    // trust them afterwards.
+    class LedgeIndexView {
+        public:
+            bool Open(std::span<const std::byte> bytes, std::string &errorOut);
+
+            bool IsOpen() const {
+                return header != nullptr;
+            }
+
+            const LedgeIndexHeader &Header() const {
+                return *header;
+            }
+
+            std::span<const BakedLedge> Ledges() const {
+                return {ledges, header ? header->ledgeCount : 0};
+            }
+
+            // Ledges of grid cell x, y, empty outside the grid
+            std::span<const BakedLedge> Cell(std::int64_t x, std::int64_t y) const;
+
+            // Every ledge in the grid cells the square of half size radius around position touches, the caller filters
+            template <class F>
+            void ForEachNear(const Vec3 &position, float radius, F &&f) const {
+                if (!header || header->gridSize <= 0.0f) {
+                    return;
+                }
+                const auto toCell = [this](float v, float origin) {
+                    return static_cast<std::int64_t>(std::floor((v - origin) / header->gridSize));
+                };
+                const std::int64_t minX = toCell(position.x - radius, header->originX);
+                const std::int64_t maxX = toCell(position.x + radius, header->originX);
+                const std::int64_t minY = toCell(position.y - radius, header->originY);
+                const std::int64_t maxY = toCell(position.y + radius, header->originY);
+                for (std::int64_t y = minY; y <= maxY; y++) {
+                    for (std::int64_t x = minX; x <= maxX; x++) {
+                        for (const auto &ledge: Cell(x, y)) {
+                            f(ledge);
+                        }
+                    }
+                }
+            }
+
+        private:
+            const LedgeIndexHeader *header = nullptr;
+            const std::uint32_t *cellTable = nullptr;
+            const BakedLedge *ledges = nullptr;
+    };
+
+    // A ledge index that keeps its bytes alive, mapped from a file or handed over from a bake
+    class LedgeIndex {
+        public:
+            bool LoadFile(const std::filesystem::path &path, std::string &errorOut);
+            bool Adopt(std::vector<std::byte> bytes, std::string &errorOut);
+            void Clear();
+
+            const LedgeIndexView &View() const {
+                return view;
+            }
+
+            bool IsMapped() const {
+                return file.IsOpen();
+            }
+
+        private:
+            MappedFile file;
+            std::vector<std::byte> owned;
+            LedgeIndexView view;
+    };
+}  // namespace ParkourCore
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "ParkourCore/CollisionScene.h"
+#include "ParkourCore/LedgeIndex.h"
+
+namespace ParkourCore {
+
+    // Layers that never move, only these are baked. Props and clutter can be picked up or knocked over,
+    // detection keeps finding their ledges with live rays.
+    constexpr bool IsBakedLayer(CollisionLayer layer) {
+        switch (layer) {
+            case CollisionLayer::kStatic:
+            case CollisionLayer::kAnimStatic:
+            case CollisionLayer::kTerrain:
+            case CollisionLayer::kGround:
+            case CollisionLayer::kTrees:
+            case CollisionLayer::kCollisionBox:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    struct LedgeBakeSettings {
+            std::uint32_t cellKey = 0;      // Written to the header, the game cell's form ID
+            float gridSize = 256.0f;        // Side of a grid cell
+            float sampleSpacing = 16.0f;    // Between ledges along one edge
+            float minWalkableZ = 0.5f;      // Normal z of a top, minLedgeFlatness
+            float minHeight = 10.0f;        // Lower edges are seams or steps, not ledges
+            float maxDropProbe = 1000.0f;   // Edges with no floor this far below are dropped
+            float probeOffset = 20.0f;      // How far off the edge the floor and the open side are probed
+            float clearanceProbe = 250.0f;  // Longest headroom ray, BakedLedge::clearance is capped here
+            float minClearance = 10.0f;     // Less than this above the top, the edge is buried under something
+    };
+
+    struct LedgeBakeStats {
+            std::uint64_t triangles = 0;       // On baked layers
+            std::uint64_t walkable = 0;        // Of those, flat enough to stand on
+            std::uint64_t openEdges = 0;       // Walkable edges no other walkable triangle shares
+            std::uint64_t samples = 0;         // Points probed along them
+            std::uint64_t ledges = 0;          // Kept
+            std::uint64_t rejectedWall = 0;    // Something rises right behind the edge
+            std::uint64_t rejectedDrop = 0;    // No floor below, or too little height
+            std::uint64_t rejectedBuried = 0;  // Less than minClearance free above the top
+    };
+
+    // Walkable top edges of the scene's baked layers, as ledge index bytes ready for LedgeIndex::Adopt or
+    // WriteLedgeIndex. A triangle edge is a top edge when no other walkable triangle shares it. It is sampled every
+    // sampleSpacing, each sample probed with rays against the scene: open past the edge, a floor below it and
+    // headroom above it. Deterministic, the same scene always bakes to the same bytes.
+    std::vector<std::byte> BakeLedgeIndex(CollisionScene &scene, const LedgeBakeSettings &settings, LedgeBakeStats *stats = nullptr);
+
+    bool WriteLedgeIndex(const std::filesystem::path &path, std::span<const std::byte> bytes);
+}  // namespace ParkourCore
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+
+namespace ParkourCore {
+
+    // Whole file mapped read only. mmap on POSIX, a file mapping on Windows. Move only, unmaps on destruction.
+    class MappedFile {
+        public:
+            MappedFile() = default;
+            ~MappedFile();
+
+            MappedFile(MappedFile &&other) noexcept;
+            MappedFile &operator=(MappedFile &&other) noexcept;
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+
+            bool Open(const std::filesystem::path &path, std::string &errorOut);
+            void Close();
+
+            bool IsOpen() const {
+                return data != nullptr;
+            }
+
+            std::span<const std::byte> Bytes() const {
+                return {data, size};
+            }
+
+        private:
+            const std::byte *data = nullptr;
+            std::size_t size = 0;
+#ifdef _WIN32
+            void *mapping = nullptr;
+#endif
+    };
+}  // namespace ParkourCore
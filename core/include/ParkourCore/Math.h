@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+
+namespace ParkourCore {
+
+    // Plain float vector, layout compatible with RE::NiPoint3 so the plugin can convert for free.
+    struct Vec3 {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+
+            constexpr Vec3() = default;
+            constexpr Vec3(float a_x, float a_y, float a_z)
+                : x(a_x), y(a_y), z(a_z) {}
+
+            constexpr Vec3 operator+(const Vec3 &rhs) const {
+                return {x + rhs.x, y + rhs.y, z + rhs.z};
+            }
+            constexpr Vec3 operator-(const Vec3 &rhs) const {
+                return {x - rhs.x, y - rhs.y, z - rhs.z};
+            }
+            constexpr Vec3 operator*(float s) const {
+                return {x * s, y * s, z * s};
+            }
+            constexpr Vec3 operator-() const {
+                return {-x, -y, -z};
+            }
+            constexpr Vec3 &operator+=(const Vec3 &rhs) {
+                x += rhs.x;
+                y += rhs.y;
+                z += rhs.z;
+                return *this;
+            }
+            constexpr bool operator==(const Vec3 &) const = default;
+
+            constexpr float Dot(const Vec3 &rhs) const {
+                return x * rhs.x + y * rhs.y + z * rhs.z;
+            }
+            constexpr Vec3 Cross(const Vec3 &rhs) const {
+                return {y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x};
+            }
+            float Length() const {
+                return std::sqrt(Dot(*this));
+            }
+    };
+
+    inline float MagnitudeXY(float x, float y) {
+        return std::sqrt(x * x + y * y);
+    }
+
+    // Flat forward vector for a yaw angle, same convention as Actor::data.angle.z
+    inline Vec3 DirFlatFromYaw(float yaw) {
+        return {std::sin(yaw), std::cos(yaw), 0.0f};
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace ParkourCore {
+
+    // Open / closed state of up to 64 menus, identified by the address of their interned name.
+    // The game pools its strings, so every event for a menu carries the same pointer and lookup is one hash probe.
+    // Update from the UI thread only; AnyOpen / IsOpen are a single atomic load and safe anywhere.
+    class MenuTracker {
+        public:
+            static constexpr int maxMenus = 64;
+
+            // Bit index for the name, or -1 when full. Registering the same name twice returns the same index.
+            int Track(const void *name) {
+                if (const int existing = IndexOf(name); existing >= 0) {
+                    return existing;
+                }
+                if (count >= maxMenus || !name) {
+                    return -1;
+                }
+                std::size_t slot = Hash(name);
+                while (keys[slot]) {
+                    slot = (slot + 1) & (tableSize - 1);
+                }
+                keys[slot] = name;
+                indices[slot] = static_cast<std::int8_t>(count);
+                return count++;
+            }
+
+            // -1 for names that aren't tracked
+            int IndexOf(const void *name) const {
+                if (!name) {
+                    return -1;
+                }
+                for (std::size_t slot = Hash(name);; slot = (slot + 1) & (tableSize - 1)) {
+                    if (keys[slot] == name) {
+                        return indices[slot];
+                    }
+                    if (!keys[slot]) {
+                        return -1;
+                    }
+                }
+            }
+
+            // Returns false for untracked names
+            bool SetOpen(const void *name, bool isOpen) {
+                const int index = IndexOf(name);
+                if (index < 0) {
+                    return false;
+                }
+                const std::uint64_t bit = std::uint64_t{1} << index;
+                if (isOpen) {
+                    openMask.fetch_or(bit, std::memory_order_relaxed);
+                }
+                else {
+                    openMask.fetch_and(~bit, std::memory_order_relaxed);
+                }
+                return true;
+            }
+
+            bool AnyOpen() const {
+                return openMask.load(std::memory_order_relaxed) != 0;
+            }
+
+            bool IsOpen(int index) const {
+                return index >= 0 && (openMask.load(std::memory_order_relaxed) >> index & 1) != 0;
+            }
+
+            int OpenCount() const {
+                return std::popcount(openMask.load(std::memory_order_relaxed));
+            }
+
+            void CloseAll() {
+                openMask.store(0, std::memory_order_relaxed);
+            }
+
+        private:
+            static constexpr std::size_t tableSize = 128;  // At most half full, probes stay short
+
+            static std::size_t Hash(const void *name) {
+                // Fibonacci hashing, low pointer bits are alignment
+                const auto value = reinterpret_cast<std::uintptr_t>(name) >> 3;
+                return static_cast<std::size_t>((static_cast<std::uint64_t>(value) * 0x9E3779B97F4A7C15ull) >> 57);
+            }
+
+            std::array<const void *, tableSize> keys{};
+            std::array<std::int8_t, tableSize> indices{};
+            int count = 0;
+            std::atomic<std::uint64_t> openMask{0};
+    };
+}  // namespace ParkourCore
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "ParkourCore/Detection.h"
+
+namespace ParkourCore {
+
+    struct NegativeCacheConfig {
+            float positionStep = 16.0f;     // Game units per position cell, two forward probes
+            int yawBuckets = 32;            // Around the full circle, ~11 degrees each
+            std::uint32_t ttlMs = 500;      // Catches doors, moving platforms and anything else the key can't see
+            float confirmTolerance = 2.0f;  // Game units the confirm ray may differ from the stored one
+    };
+
+    // Distances of the confirm rays, see NegativeCache
+    struct NegativeConfirm {
+            float up = 0.0f;       // LedgeCheck's headroom ray
+            float forward = 0.0f;  // LedgeCheck's forward ray, from under the headroom ray's end
+            float face = 0.0f;     // Straight ahead just under the climb band
+    };
+
+    // Where a NoLedge result was found, quantised coarser than DetectionKey so walking through open ground repeats keys
+    struct NegativeKey {
+            std::int32_t x = 0;
+            std::int32_t y = 0;
+            std::int32_t z = 0;
+            std::int32_t waterHeight = 0;
+            std::uint16_t yaw = 0;
+            std::uint8_t flags = 0;
+
+            bool operator==(const NegativeKey &) const = default;
+    };
+
+    // Remembers where detection found nothing, a fixed size set associative table so memory never grows. A fresh entry
+    // is confirmed with three rays, LedgeCheck's up and forward pair and one just under the climb band: if they still end
+    // where they did when the entry was stored, nothing ahead has changed. A miss is only stored when down rays past
+    // both checks' reach find nothing on top in the climb or vault band, so a move across the cell can't bring a rail
+    // or slab into reach the confirm rays don't see.
+    // Invalidated on cell or scale change, entries expire after ttlMs.
+    // Not thread safe, owned by whoever runs detection.
+    class NegativeCache {
+        public:
+            static constexpr std::size_t setCount = 64;
+            static constexpr std::size_t ways = 4;
+
+            struct Stats {
+                    std::uint64_t lookups = 0;
+                    std::uint64_t hits = 0;             // A fresh entry answered, its confirm rays unchanged
+                    std::uint64_t confirmFailures = 0;  // A confirm ray moved, the entry was dropped
+                    std::uint64_t refused = 0;          // Not stored, something in band just past the reach
+                    std::uint64_t expired = 0;          // Found but older than ttlMs
+                    std::uint64_t stores = 0;
+                    std::uint64_t evictions = 0;  // Live entries pushed out of a full set
+                    std::uint64_t raysSaved = 0;  // Rays the answered decisions cost when they were computed, minus confirm rays
+                    std::uint64_t raysCast = 0;   // Confirm and lookahead rays, including the ones cast when storing
+                    std::uint64_t invalidations = 0;
+
+                    double HitRate() const {
+                        return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+                    }
+            };
+
+            explicit NegativeCache(const NegativeCacheConfig &a_config = {})
+                : config(a_config) {}
+
+            NegativeKey MakeKey(const PlayerState &player, bool smartParkour) const;
+
+            // Drops everything when the cell or scale differs from the last call. Thresholds follow the scale.
+            void SetContext(std::uint32_t cellId, float scale);
+            void Invalidate();
+
+            // True when a fresh entry says there is no ledge and its three confirm rays still end where they did
+            bool Check(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, const NegativeKey &key,
+                       std::uint64_t nowMs);
+            // Remembers a NoLedge result that cost rays to find. Casts the lookahead rays, then the three confirm rays.
+            void Store(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, const NegativeKey &key,
+                       std::uint64_t rays, std::uint64_t nowMs);
+            // A ledge was found under this key, a stale entry must not outlive it
+            void Erase(const NegativeKey &key);
+
+            void SetConfig(const NegativeCacheConfig &a_config);
+            const NegativeCacheConfig &Config() const {
+                return config;
+            }
+
+            const Stats &GetStats() const {
+                return stats;
+            }
+            void ResetStats() {
+                stats = {};
+            }
+
+        private:
+            struct Entry {
+                    NegativeKey key;
+                    NegativeConfirm confirm;
+                    std::uint32_t rays = 0;
+                    std::uint64_t storedMs = 0;
+                    bool valid = false;
+            };
+
+            using Set = std::array<Entry, ways>;
+
+            Set &SetFor(const NegativeKey &key);
+            Entry *Lookup(const NegativeKey &key);
+
+            NegativeCacheConfig config;
+            std::array<Set, setCount> sets;
+            std::uint32_t cell = 0;
+            float contextScale = 0.0f;
+            Stats stats;
+    };
+}  // namespace ParkourCore
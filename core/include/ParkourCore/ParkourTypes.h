@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string_view>
+
+namespace ParkourCore {
+
+    namespace HardCodedVariables {
+        // Lower - upper limits for ledge - vault detection.
+        inline constexpr float climbMaxHeight = 250.0f;
+        inline constexpr float climbMinHeight = 20.0f;
+
+        inline constexpr float vaultMaxHeight = 90.0f;
+        inline constexpr float vaultMinHeight = 40.5f;
+
+        // These are the height ranges for parkour type selection, represent low limits.
+        inline constexpr float highestLedgeLimit = 220.0f;
+        inline constexpr float highLedgeLimit = 170.0f;
+        inline constexpr float medLedgeLimit = 123.0f;
+        inline constexpr float lowLedgeLimit = 80.0f;
+        inline constexpr float highStepLimit = 40.0f;
+
+        // These are the ending heights for each animation, they are dependent on animmotion data.
+        inline constexpr float highestLedgeElevation = 250.0f;
+        inline constexpr float highLedgeElevation = 200.0f;
+        inline constexpr float medLedgeElevation = 153.0f;
+        inline constexpr float lowLedgeElevation = 110.0f;
+
+        inline constexpr float stepHighElevation = 70.0f;
+        inline constexpr float stepLowElevation = 50.0f;
+
+        // This is exception, vault needs to put player further below. Elevation is 20, plus 40 adjustment
+        inline constexpr float vaultElevation = 60.0f;
+
+        inline constexpr float grabElevation = 60.0f;
+    }  // namespace HardCodedVariables
+
+    namespace ParkourType {
+        inline constexpr int Highest = 8;
+        inline constexpr int High = 7;
+
+        inline constexpr int Medium = 6;
+        inline constexpr int Low = 5;
+        inline constexpr int StepHigh = 4;
+        inline constexpr int StepLow = 3;
+
+        inline constexpr int Vault = 2;
+
+        inline constexpr int Grab = 1;
+
+        inline constexpr int Failed = 0;
+
+        inline constexpr int NoLedge = -1;
+
+        constexpr std::string_view Name(int type) {
+            switch (type) {
+                case Highest:
+                    return "Highest";
+                case High:
+                    return "High";
+                case Medium:
+                    return "Medium";
+                case Low:
+                    return "Low";
+                case StepHigh:
+                    return "StepHigh";
+                case StepLow:
+                    return "StepLow";
+                case Vault:
+                    return "Vault";
+                case Grab:
+                    return "Grab";
+                case Failed:
+                    return "Failed";
+                case NoLedge:
+                    return "NoLedge";
+                default:
+                    return "Invalid";
+            }
+        }
+    }  // namespace ParkourType
+}  // namespace ParkourCore
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <limits>
+
+#include "ParkourCore/Math.h"
+
+namespace ParkourCore {
+
+    // Everything detection needs to know about the player, captured once per decision on the main thread.
+    struct PlayerState {
+            Vec3 position;
+            float yaw = 0.0f;  // Actor::data.angle.z
+            float scale = 1.0f;
+
+            bool isMoving = false;
+            bool isGroundedOrSliding = true;
+            bool isMidairAndNotSliding = false;
+            bool isSwimming = false;
+            bool isOnStairs = false;
+
+            // Stamina options say climbing should play the failed animation instead
+            bool shouldReplaceWithFailed = false;
+
+            // Water surface at the player's position, lowest float if there is no water
+            float waterHeight = std::numeric_limits<float>::lowest();
+
+            // Flat direction the player moves in, zero when unknown. Differs from the facing while a movement mod
+            // turns the character after the input.
+            Vec3 moveDir;
+
+            // Character controller velocity, game units per second
+            Vec3 velocity;
+    };
+}  // namespace ParkourCore
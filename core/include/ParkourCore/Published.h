@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace ParkourCore {
+
+    // RCU style publication of an immutable value. Readers enter a read section (two atomic increments, no locks),
+    // load one pointer and see one consistent version. Writers copy, modify and swap the pointer, the old version is
+    // retired and freed by a later publish once every read section that could still see it has ended (a grace period,
+    // two epoch flips as in SRCU). Writers are serialised and never wait for readers, a flip whose phase still has
+    // readers is simply tried again on the next publish.
+    template <class T>
+    class Published {
+        public:
+            // Read section, keeps the version it saw alive
+            class Snapshot {
+                public:
+                    Snapshot(Snapshot &&other) noexcept
+                        : owner(std::exchange(other.owner, nullptr)), value(other.value), phase(other.phase) {}
+                    Snapshot(const Snapshot &) = delete;
+                    Snapshot &operator=(const Snapshot &) = delete;
+                    Snapshot &operator=(Snapshot &&) = delete;
+
+                    ~Snapshot() {
+                        if (owner) {
+                            owner->readers[phase].count.fetch_sub(1, std::memory_order_release);
+                        }
+                    }
+
+                    const T &operator*() const {
+                        return *value;
+                    }
+                    const T *operator->() const {
+                        return value;
+                    }
+
+                private:
+                    friend class Published;
+
+                    Snapshot(const Published *a_owner, const T *a_value, unsigned a_phase)
+                        : owner(a_owner), value(a_value), phase(a_phase) {}
+
+                    const Published *owner;
+                    const T *value;
+                    unsigned phase;
+            };
+
+            explicit Published(T initial = T{})
+                : current(new T(std::move(initial))) {}
+
+            // No read section may outlive the owner
+            ~Published() {
+                for (const auto &entry: retired) {
+                    delete entry.value;
+                }
+                delete current.load(std::memory_order_acquire);
+            }
+
+            Published(const Published &) = delete;
+            Published &operator=(const Published &) = delete;
+
+            Snapshot Read() const {
+                for (;;) {
+                    const unsigned phase = epoch.load(std::memory_order_seq_cst) & 1;
+                    readers[phase].count.fetch_add(1, std::memory_order_seq_cst);
+                    // The writer may have flipped between the two lines. Retrying keeps every reader on the phase
+                    // of the epoch it loads the pointer in, so a grace period never misses one.
+                    if ((epoch.load(std::memory_order_seq_cst) & 1) == phase) {
+                        return Snapshot(this, current.load(std::memory_order_seq_cst), phase);
+                    }
+                    readers[phase].count.fetch_sub(1, std::memory_order_release);
+                }
+            }
+
+            // Consistent copy, for small trivially copyable settings where holding a read section is not worth it
+            T Load() const {
+                return *Read();
+            }
+
+            void Publish(T value) {
+                std::scoped_lock guard(writeLock);
+                Swap(new T(std::move(value)));
+            }
+
+            // Copy the current value, let mutate change the copy, publish it. Returns the published value.
+            template <class F>
+            T Update(F &&mutate) {
+                std::scoped_lock guard(writeLock);
+                T next = *current.load(std::memory_order_acquire);
+                std::forward<F>(mutate)(next);
+                Swap(new T(next));
+                return next;
+            }
+
+            std::uint64_t Version() const {
+                return version.load(std::memory_order_acquire);
+            }
+
+            std::uint64_t Reclaimed() const {
+                return reclaimed.load(std::memory_order_relaxed);
+            }
+
+            // Versions retired but not yet freed
+            std::size_t Retired() const {
+                std::scoped_lock guard(writeLock);
+                return retired.size();
+            }
+
+        private:
+            struct alignas(64) ReaderCount {
+                    mutable std::atomic<std::uint64_t> count{0};
+            };
+
+            struct RetiredVersion {
+                    const T *value;
+                    std::uint64_t epoch;  // Epoch it was replaced in
+            };
+
+            // Called with writeLock held
+            void Swap(const T *next) {
+                const T *previous = current.exchange(next, std::memory_order_seq_cst);
+                version.fetch_add(1, std::memory_order_acq_rel);
+                retired.push_back({previous, epoch.load(std::memory_order_seq_cst)});
+                Reclaim();
+            }
+
+            // A reader that can still see a version replaced in epoch E loaded the pointer in epoch E or earlier, so
+            // it counts in phase E & 1 or (E + 1) & 1. Flipping to E + 1 needs the second one drained and flipping
+            // to E + 2 the first, both checked after the replace. The version is free once the epoch reaches E + 2.
+            // A phase with readers left stops the flips, they are retried next time.
+            void Reclaim() {
+                for (int flip = 0; flip < 2; flip++) {
+                    const std::uint64_t now = epoch.load(std::memory_order_seq_cst);
+                    if (readers[(now + 1) & 1].count.load(std::memory_order_seq_cst) != 0) {
+                        break;
+                    }
+                    epoch.store(now + 1, std::memory_order_seq_cst);
+                }
+
+                // Retired in epoch order, the oldest come first
+                const std::uint64_t now = epoch.load(std::memory_order_seq_cst);
+                while (!retired.empty() && retired.front().epoch + 2 <= now) {
+                    delete retired.front().value;
+                    retired.pop_front();
+                    reclaimed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            std::atomic<const T *> current;
+            std::atomic<std::uint64_t> epoch{0};
+            ReaderCount readers[2];
+            std::atomic<std::uint64_t> version{0};
+            std::atomic<std::uint64_t> reclaimed{0};
+            std::deque<RetiredVersion> retired;  // writeLock
+            mutable std::mutex writeLock;
+    };
+}  // namespace ParkourCore
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "ParkourCore/RayBatch.h"
+#include "ParkourCore/ScaledThresholds.h"
+
+namespace ParkourCore {
+
+    // Probe counts of each fixed tier. Detection runs its linear probe loops with these as compile time counts, every
+    // tier gets its own unrolled loop (see Detection.cpp), Custom keeps the runtime counts. adaptiveForward makes the
+    // ledge check use ProbeSearch::Adaptive whatever is tuned.
+    template <int Tier>
+    struct TierSpec;
+
+    // Thins every search, loses ledges: 52 of the 684 bench corpus decisions find none where High finds one
+    template <>
+    struct TierSpec<DetectionQuality::Low> {
+            static constexpr int tier = DetectionQuality::Low;
+            static constexpr int ledgeForwardIterations = 5;
+            static constexpr int vaultDownIterations = 8;
+            static constexpr int headingCount = 4;
+            static constexpr bool adaptiveForward = false;
+    };
+
+    // High's probes, the forward ones found with fewer rays. Decides what High decides on every corpus pose
+    // (DetectionSearchTest), fewer probes over the same reach move or lose ledges.
+    template <>
+    struct TierSpec<DetectionQuality::Medium> {
+            static constexpr int tier = DetectionQuality::Medium;
+            static constexpr int ledgeForwardIterations = baseThresholds.ledgeForwardIterations;
+            static constexpr int vaultDownIterations = baseThresholds.vaultDownIterations;
+            static constexpr int headingCount = baseThresholds.headingCount;
+            static constexpr bool adaptiveForward = true;
+    };
+
+    template <>
+    struct TierSpec<DetectionQuality::High> {
+            static constexpr int tier = DetectionQuality::High;
+            static constexpr int ledgeForwardIterations = baseThresholds.ledgeForwardIterations;
+            static constexpr int vaultDownIterations = baseThresholds.vaultDownIterations;
+            static constexpr int headingCount = baseThresholds.headingCount;
+            static constexpr bool adaptiveForward = false;
+    };
+
+    // The tier's counts over the same reach as tuned, the probes are spread further apart instead of reaching less far
+    template <class Spec>
+    constexpr ScaledThresholds WithTier(const ScaledThresholds &tuned) {
+        static_assert(Spec::ledgeForwardIterations > 1 && Spec::vaultDownIterations > 1);
+        static_assert(Spec::vaultDownIterations <= static_cast<int>(RayBatch::kCapacity));
+
+        const float ledgeReach = tuned.ledgeForwardStep * static_cast<float>(tuned.ledgeForwardIterations - 1);
+        const float vaultReach = tuned.vaultDownStep * static_cast<float>(tuned.vaultDownIterations - 1);
+
+        ScaledThresholds t = tuned;
+        t.quality = Spec::tier;
+        t.ledgeForwardStep = ledgeReach / static_cast<float>(Spec::ledgeForwardIterations - 1);
+        t.vaultDownStep = vaultReach / static_cast<float>(Spec::vaultDownIterations - 1);
+        t.ledgeForwardIterations = Spec::ledgeForwardIterations;
+        t.vaultDownIterations = Spec::vaultDownIterations;
+        t.headingCount = Spec::headingCount;
+        if (Spec::adaptiveForward) {
+            t.ledgeForwardSearch = ProbeSearch::Adaptive;
+        }
+        return t;
+    }
+
+    // Thresholds for detection at a fixed tier. Custom and Auto (resolve it with QualityGovernor first) return tuned.
+    constexpr ScaledThresholds WithQuality(const ScaledThresholds &tuned, int tier) {
+        switch (tier) {
+            case DetectionQuality::Low:
+                return WithTier<TierSpec<DetectionQuality::Low>>(tuned);
+            case DetectionQuality::Medium:
+                return WithTier<TierSpec<DetectionQuality::Medium>>(tuned);
+            case DetectionQuality::High:
+                return WithTier<TierSpec<DetectionQuality::High>>(tuned);
+            default:
+                return tuned;
+        }
+    }
+
+    static_assert(WithQuality(baseThresholds, DetectionQuality::High).ledgeForwardStep == baseThresholds.ledgeForwardStep);
+    static_assert(WithQuality(baseThresholds, DetectionQuality::High).vaultDownStep == baseThresholds.vaultDownStep);
+
+    // Tier for DetectionQuality::Auto. Steps down a tier while the last frames average longer than downMs and up a
+    // tier while they average shorter than upMs, the gap between the two keeps it from flapping. After a change the
+    // average starts over and the tier is held for holdFrames. Never below lowestTier, frame time alone doesn't get to
+    // cost ledges. Not thread safe, fed and read on one thread.
+    class QualityGovernor {
+        public:
+            static constexpr int window = 30;       // Frames averaged
+            static constexpr int holdFrames = 120;  // ~2 seconds at 60 fps
+            static constexpr int lowestTier = DetectionQuality::Medium;  // The lowest that decides like High on the corpus
+
+            struct Stats {
+                    std::uint64_t frames = 0;
+                    std::uint64_t stepsDown = 0;
+                    std::uint64_t stepsUp = 0;
+                    std::array<std::uint64_t, 3> framesAt{};  // Frames spent at Low, Medium and High
+            };
+
+            // True when the tier changed
+            bool AddFrame(float frameMs, float downMs, float upMs);
+
+            int Tier() const {
+                return tier;
+            }
+            void Reset(int a_tier = DetectionQuality::High);
+
+            const Stats &GetStats() const {
+                return stats;
+            }
+
+        private:
+            std::array<float, window> samples{};
+            int count = 0;
+            int next = 0;
+            float sum = 0.0f;
+            int held = holdFrames;
+            int tier = DetectionQuality::High;
+            Stats stats;
+    };
+}  // namespace ParkourCore
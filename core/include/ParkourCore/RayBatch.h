@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "ParkourCore/CollisionLayer.h"
+#include "ParkourCore/Math.h"
+
+namespace ParkourCore {
+
+    // Result of a single probe. Everything a caller needs is in here, no shared state is written.
+    // distance keeps the old ParkourUtility::RayCast convention:
+    // maxDist when nothing was hit, -1 when a non parkour layer was hit, hit distance otherwise.
+    struct RayHit {
+            float distance = 0.0f;
+            Vec3 normal;
+            CollisionLayer layer = CollisionLayer::kUnidentified;
+            float hitFraction = 1.0f;
+            bool valid = false;  // Hit a parkour surface
+
+            bool HasHit() const {
+                return hitFraction < 1.0f;
+            }
+    };
+
+    inline RayHit MakeMiss(float maxDist) {
+        return {maxDist, {}, CollisionLayer::kUnidentified, 1.0f, false};
+    }
+
+    inline RayHit MakeHit(float maxDist, float hitFraction, const Vec3 &normal, CollisionLayer layer) {
+        if (layer == CollisionLayer::kUnidentified || !IsParkourSurface(layer)) {
+            return {-1.0f, normal, layer, hitFraction, false};  // Invalid layer hit
+        }
+        return {maxDist * hitFraction, normal, layer, hitFraction, true};
+    }
+
+    // Fixed capacity struct-of-arrays ray batch. Lives on the stack, no allocation per decision.
+    class RayBatch {
+        public:
+            static constexpr std::size_t kCapacity = 64;
+
+            std::size_t Add(const Vec3 &origin, const Vec3 &dir, float maxDist) {
+                assert(count < kCapacity);
+                const std::size_t i = count++;
+                originX[i] = origin.x;
+                originY[i] = origin.y;
+                originZ[i] = origin.z;
+                dirX[i] = dir.x;
+                dirY[i] = dir.y;
+                dirZ[i] = dir.z;
+                maxDists[i] = maxDist;
+                return i;
+            }
+
+            void Clear() {
+                count = 0;
+            }
+
+            std::size_t Size() const {
+                return count;
+            }
+            bool Full() const {
+                return count == kCapacity;
+            }
+
+            Vec3 Origin(std::size_t i) const {
+                return {originX[i], originY[i], originZ[i]};
+            }
+            Vec3 Dir(std::size_t i) const {
+                return {dirX[i], dirY[i], dirZ[i]};
+            }
+            float MaxDist(std::size_t i) const {
+                return maxDists[i];
+            }
+
+            // Inputs
+            std::array<float, kCapacity> originX;
+            std::array<float, kCapacity> originY;
+            std::array<float, kCapacity> originZ;
+            std::array<float, kCapacity> dirX;
+            std::array<float, kCapacity> dirY;
+            std::array<float, kCapacity> dirZ;
+            std::array<float, kCapacity> maxDists;
+
+            // Outputs, filled by WorldQuery::CastBatch
+            std::array<RayHit, kCapacity> results;
+
+        private:
+            std::size_t count = 0;
+    };
+
+    // Collision world seen by the detection code. Implementations resolve their world context once
+    // (on construction or per batch) and then execute every ray of a batch in one pass.
+    class WorldQuery {
+        public:
+            virtual ~WorldQuery() = default;
+
+            virtual void CastBatch(RayBatch &batch) = 0;
+
+            // Single ray convenience, defaults to a one element batch
+            virtual RayHit CastRay(const Vec3 &origin, const Vec3 &dir, float maxDist);
+
+            // Axis aligned box centred on origin, moved along dir. Same distance convention as CastRay, 0 when the box
+            // already overlaps something at the start. Defaults to one batch of rays from the box corners and centre,
+            // which misses anything thin enough to pass between them.
+            virtual RayHit SweepBox(const Vec3 &origin, const Vec3 &halfExtents, const Vec3 &dir, float maxDist);
+    };
+}  // namespace ParkourCore
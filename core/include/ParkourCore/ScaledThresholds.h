@@ -0,0 +1,183 @@
+#pragma once
+
+#include "ParkourCore/ParkourTypes.h"
+
+namespace ParkourCore {
+
+    // How a probe sweep looks for its hit
+    namespace ProbeSearch {
+        inline constexpr int Linear = 0;    // Every sample in order, the original behaviour
+        inline constexpr int Adaptive = 1;  // Long rays find the obstacle first, then only samples around its edge
+    }  // namespace ProbeSearch
+
+    // How LedgeCheck makes sure the player fits on the ledge
+    namespace ClearanceCheck {
+        inline constexpr int Ray = 0;    // One ray up from the ledge point and one behind the edge, the original behaviour
+        inline constexpr int Sweep = 1;  // Both swept as boxes clearanceRadius wide, catches beams and overhangs off the ray
+    }  // namespace ClearanceCheck
+
+    // Whether DetectionCache remembers where detection found nothing (see NegativeCache.h)
+    namespace NegativeCacheMode {
+        inline constexpr int Off = 0;
+        inline constexpr int Confirm = 1;  // Three rays confirm a remembered NoLedge, anything moved ahead runs detection
+    }  // namespace NegativeCacheMode
+
+    // Probe density of detection (see QualityTier.h)
+    namespace DetectionQuality {
+        inline constexpr int Custom = 0;  // Ledge, Vault and Heading counts as tuned, the original behaviour
+        inline constexpr int Low = 1;
+        inline constexpr int Medium = 2;
+        inline constexpr int High = 3;  // The default counts
+        inline constexpr int Auto = 4;  // Medium to High from recent frame times, see QualityGovernor
+    }  // namespace DetectionQuality
+
+    // Every distance detection and positioning use, in one block. The member initialisers are the unscaled base
+    // values (game units at scale 1), a tuning file may replace them (see Tuning.h). Scaled() multiplies them once,
+    // callers keep the result until the scale changes and pass it down by reference instead of multiplying on every probe.
+    struct ScaledThresholds {
+            float scale = 1.0f;
+
+            // Detection ranges, relative to the player's feet
+            float climbMinHeight = HardCodedVariables::climbMinHeight;
+            float climbMaxHeight = HardCodedVariables::climbMaxHeight;
+            float vaultMinHeight = HardCodedVariables::vaultMinHeight;
+            float vaultMaxHeight = HardCodedVariables::vaultMaxHeight;
+            float vaultMaxElevationIncrease = 70.0f;  // Landing side may be at most this much higher
+
+            // Classification, low limit of each band
+            float highestLedgeLimit = HardCodedVariables::highestLedgeLimit;
+            float highLedgeLimit = HardCodedVariables::highLedgeLimit;
+            float medLedgeLimit = HardCodedVariables::medLedgeLimit;
+            float lowLedgeLimit = HardCodedVariables::lowLedgeLimit;
+            float highStepLimit = HardCodedVariables::highStepLimit;
+            float grabMaxHeight = 100.0f;  // Midair grab reach above the feet
+
+            // LedgeCheck
+            float ledgeStartZOffset = 100.0f;    // Up ray origin above the feet
+            float ledgeMinUpCheck = 100.0f;      // Less headroom than this above the start and there is no climbing
+            float ledgeUpCheckMargin = 20.0f;    // Up ray reach past the climb range
+            float ledgeForwardStep = 8.0f;       // Spacing of the forward probes
+            float ledgeObstructionDist = 10.0f;  // Free space needed behind the edge
+            float standingHeight = 120.0f;       // Headroom needed on the ledge
+            float headroomBuffer = 10.0f;
+            float clearanceRadius = 15.0f;  // Half width of the swept boxes in ClearanceCheck::Sweep
+
+            // VaultCheck
+            float vaultHeadHeight = 120.0f;
+            float vaultObstructionDist = 100.0f;  // Free space needed behind the obstacle
+
+            // Positioning, player ends this far back from the ledge point
+            float backwardOffset = 55.0f;
+            float stepBackwardOffset = 30.0f;
+            float grabBackwardOffset = 40.0f;
+
+            // Grab prediction, recompute once the player is this far off the predicted path
+            float grabPathTolerance = 10.0f;
+
+            // Animation end heights minus a small margin, the player is placed this far below the ledge point
+            float highestLedgeElevation = HardCodedVariables::highestLedgeElevation - 3;
+            float highLedgeElevation = HardCodedVariables::highLedgeElevation - 3;
+            float medLedgeElevation = HardCodedVariables::medLedgeElevation - 3;
+            float lowLedgeElevation = HardCodedVariables::lowLedgeElevation - 3;
+            float stepHighElevation = HardCodedVariables::stepHighElevation - 5;
+            float stepLowElevation = HardCodedVariables::stepLowElevation - 5;
+            float vaultElevation = HardCodedVariables::vaultElevation - 3;
+            float grabElevation = HardCodedVariables::grabElevation - 3;
+
+            // Not scaled
+            float vaultLength = 85.0f;      // Forward reach of the vault probe
+            float vaultDownStep = 5.0f;     // Spacing of the vault down rays
+            float minLedgeFlatness = 0.5f;  // Normal z of the surface to stand on
+            int ledgeForwardIterations = 10;
+            int ledgeForwardSearch = ProbeSearch::Linear;
+            int ledgeClearance = ClearanceCheck::Ray;
+            int negativeCache = NegativeCacheMode::Off;
+            int cacheTtlMs = 250;  // How long DetectionCache reuses a decision
+            int vaultDownIterations = 20;  // At most RayBatch::kCapacity, they go out as one batch
+
+            // Heading scan (see HeadingScan.h), not scaled
+            int headingCount = 8;                  // Headings around the full circle, at most 32
+            int headingRayBudget = 75;             // Rays and sweeps per scan, the reach batch and one decision
+            float headingDistanceWeight = 0.005f;  // Radians of heading a game unit of ledge distance is worth
+
+            // Grab prediction (see GrabPrediction.h), not scaled
+            int grabPrediction = 0;      // 1 = predict midair grabs along the jump or fall
+            float grabHorizon = 0.6f;    // Seconds ahead, at most maxGrabPathSteps prediction steps
+            float grabGravity = 686.0f;  // Game units per second squared, 9.8 m/s2 at 70 units per metre
+
+            // Time slicing (see DetectionJob.h), not scaled. Both 0 runs every decision in one go.
+            int sliceCasts = 0;         // Rays and sweeps per frame
+            int sliceMicroseconds = 0;  // Wall time per frame
+
+            // Quality tiers (see QualityTier.h), not scaled
+            int quality = DetectionQuality::Custom;
+            float qualityDownMs = 20.0f;  // Auto steps down while frames average longer than this
+            float qualityUpMs = 14.0f;    // and back up while they average shorter than this
+
+            // Expects unscaled values, scale 1
+            constexpr ScaledThresholds Scaled(float a_scale) const {
+                ScaledThresholds t = *this;
+                t.scale = a_scale;
+                for (const auto field: scaledFields) {
+                    t.*field *= a_scale;
+                }
+                return t;
+            }
+
+            // From the compiled in base values
+            static constexpr ScaledThresholds ForScale(float a_scale) {
+                return ScaledThresholds{}.Scaled(a_scale);
+            }
+
+            bool operator==(const ScaledThresholds &) const = default;
+
+            // Animation end height for a ledge type, 0 for types that don't move the player
+            constexpr float Elevation(int ledgeType) const {
+                switch (ledgeType) {
+                    case ParkourType::Highest:
+                        return highestLedgeElevation;
+                    case ParkourType::High:
+                        return highLedgeElevation;
+                    case ParkourType::Medium:
+                        return medLedgeElevation;
+                    case ParkourType::Low:
+                        return lowLedgeElevation;
+                    case ParkourType::StepHigh:
+                        return stepHighElevation;
+                    case ParkourType::StepLow:
+                        return stepLowElevation;
+                    case ParkourType::Vault:
+                        return vaultElevation;
+                    case ParkourType::Grab:
+                        return grabElevation;
+                    default:
+                        return 0.0f;
+                }
+            }
+
+        private:
+            static constexpr float ScaledThresholds::*scaledFields[] = {
+                &ScaledThresholds::climbMinHeight,        &ScaledThresholds::climbMaxHeight,
+                &ScaledThresholds::vaultMinHeight,        &ScaledThresholds::vaultMaxHeight,
+                &ScaledThresholds::vaultMaxElevationIncrease,
+                &ScaledThresholds::highestLedgeLimit,     &ScaledThresholds::highLedgeLimit,
+                &ScaledThresholds::medLedgeLimit,         &ScaledThresholds::lowLedgeLimit,
+                &ScaledThresholds::highStepLimit,         &ScaledThresholds::grabMaxHeight,
+                &ScaledThresholds::ledgeStartZOffset,     &ScaledThresholds::ledgeMinUpCheck,
+                &ScaledThresholds::ledgeUpCheckMargin,    &ScaledThresholds::ledgeForwardStep,
+                &ScaledThresholds::ledgeObstructionDist,  &ScaledThresholds::standingHeight,
+                &ScaledThresholds::headroomBuffer,        &ScaledThresholds::clearanceRadius,
+                &ScaledThresholds::vaultHeadHeight,       &ScaledThresholds::vaultObstructionDist,
+                &ScaledThresholds::backwardOffset,        &ScaledThresholds::stepBackwardOffset,
+                &ScaledThresholds::grabBackwardOffset,    &ScaledThresholds::grabPathTolerance,
+                &ScaledThresholds::highestLedgeElevation, &ScaledThresholds::highLedgeElevation,
+                &ScaledThresholds::medLedgeElevation,     &ScaledThresholds::lowLedgeElevation,
+                &ScaledThresholds::stepHighElevation,     &ScaledThresholds::stepLowElevation,
+                &ScaledThresholds::vaultElevation,        &ScaledThresholds::grabElevation};
+    };
+
+    // Unscaled base values
+    inline constexpr ScaledThresholds baseThresholds{};
+    static_assert(ScaledThresholds::ForScale(2.0f).climbMaxHeight == 2.0f * HardCodedVariables::climbMaxHeight);
+    static_assert(ScaledThresholds::ForScale(2.0f).vaultLength == baseThresholds.vaultLength);
+}  // namespace ParkourCore
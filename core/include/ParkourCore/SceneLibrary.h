@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ParkourCore/CollisionScene.h"
+#include "ParkourCore/PlayerState.h"
+
+namespace ParkourCore {
+
+    // Generated test scenes. The player stands at the origin on kGround at z = 0 and faces +Y (yaw 0),
+    // obstacles start obstacleDistance units in front of them.
+    namespace SceneLibrary {
+        inline constexpr float obstacleDistance = 40.0f;
+        inline constexpr float groundHalfSize = 2000.0f;
+
+        void AddGround(CollisionScene &scene, float z = 0.0f);
+
+        CollisionScene Flat();
+        CollisionScene Wall(float height, float depth = 200.0f);
+        CollisionScene Stairs(int steps, float rise, float run);
+        CollisionScene Fence(float height, float thickness = 6.0f);
+        CollisionScene Rail(float height, float thickness = 8.0f);
+        CollisionScene LowWall(float height, float thickness = 40.0f);
+        CollisionScene Slope(float angleDegrees);
+        CollisionScene WaterPlane(float waterHeight, float ledgeHeight);
+        CollisionScene Overhang(float ledgeHeight, float clearance);
+        CollisionScene Beam(float ledgeHeight, float clearance, float offset);
+
+        struct Case {
+                std::string name;
+                CollisionScene scene;
+                PlayerState player;
+        };
+
+        // Walls for every ledge height band (40/80/123/170/220), fences, rails, stairs, slopes, water, overhangs and beams,
+        // each with a standing and a moving pose.
+        std::vector<Case> StandardCorpus();
+    }  // namespace SceneLibrary
+}  // namespace ParkourCore
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace ParkourCore {
+
+    // Sequence lock for a small trivially copyable value. Readers never block the writer, they copy and retry if a
+    // store overlapped. Every store bumps the generation by one, so a reader also learns which store it saw.
+    // Stores from several threads are serialised by the odd sequence number, meant for rare writers and one hot writer.
+    template <class T>
+    class SeqLock {
+            static_assert(std::is_trivially_copyable_v<T>, "SeqLock copies T as raw words");
+
+        public:
+            explicit SeqLock(const T &initial = T{}) {
+                WriteWords(initial);
+            }
+
+            SeqLock(const SeqLock &) = delete;
+            SeqLock &operator=(const SeqLock &) = delete;
+
+            // Returns the generation of the copied value, 0 for the initial value
+            std::uint64_t Load(T &out) const {
+                for (;;) {
+                    const std::uint64_t before = sequence.load(std::memory_order_acquire);
+                    if (before & 1) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    ReadWords(out);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence.load(std::memory_order_relaxed) == before) {
+                        return before / 2;
+                    }
+                }
+            }
+
+            T Load() const {
+                T out;
+                Load(out);
+                return out;
+            }
+
+            // Returns the generation of the stored value
+            std::uint64_t Store(const T &value) {
+                std::uint64_t before = sequence.load(std::memory_order_relaxed);
+                for (;;) {
+                    if (before & 1) {
+                        std::this_thread::yield();
+                        before = sequence.load(std::memory_order_relaxed);
+                    }
+                    else if (sequence.compare_exchange_weak(before, before + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                // Readers that see any new word must also see the odd sequence
+                std::atomic_thread_fence(std::memory_order_release);
+                WriteWords(value);
+                sequence.store(before + 2, std::memory_order_release);
+                return before / 2 + 1;
+            }
+
+            std::uint64_t Generation() const {
+                return sequence.load(std::memory_order_acquire) / 2;
+            }
+
+        private:
+            static constexpr std::size_t wordCount = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+            // Copied word by word through relaxed atomics, a torn copy is discarded but must not be a data race
+            void ReadWords(T &out) const {
+                std::array<std::uint64_t, wordCount> buffer;
+                for (std::size_t i = 0; i < wordCount; i++) {
+                    buffer[i] = words[i].load(std::memory_order_relaxed);
+                }
+                std::memcpy(static_cast<void *>(&out), buffer.data(), sizeof(T));
+            }
+
+            void WriteWords(const T &value) {
+                std::array<std::uint64_t, wordCount> buffer{};
+                std::memcpy(buffer.data(), &value, sizeof(T));
+                for (std::size_t i = 0; i < wordCount; i++) {
+                    words[i].store(buffer[i], std::memory_order_relaxed);
+                }
+            }
+
+            std::atomic<std::uint64_t> sequence{0};
+            std::array<std::atomic<std::uint64_t>, wordCount> words{};
+    };
+}  // namespace ParkourCore
\ No newline at end of file
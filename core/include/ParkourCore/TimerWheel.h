@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "ParkourCore/InplaceTask.h"
+
+namespace ParkourCore {
+
+    // Hashed timer wheel for delayed callbacks, one wheel in milliseconds and one in frames.
+    // The owner calls Advance() once per frame on the thread that should run the callbacks.
+    // Scheduling and cancelling are safe from any thread, callbacks run outside the lock and may schedule again.
+    class TimerWheel {
+        public:
+            static constexpr std::size_t taskCapacity = 48;
+            using Callback = InplaceTask<taskCapacity>;
+
+            // Cancellation handle, stale handles are rejected through the generation
+            struct Handle {
+                    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+                    std::uint32_t generation = 0;
+
+                    bool IsValid() const {
+                        return index != std::numeric_limits<std::uint32_t>::max();
+                    }
+            };
+
+            explicit TimerWheel(std::uint64_t startMs = 0);
+
+            Handle AfterMs(std::uint64_t nowMs, std::uint32_t delayMs, Callback callback);
+            Handle AfterFrames(std::uint32_t frames, Callback callback);
+
+            // True if the timer was still pending
+            bool Cancel(Handle handle);
+
+            // Moves the ms clock to nowMs and the frame clock one frame ahead, runs what is due in deadline order.
+            // Returns the number of callbacks run.
+            std::size_t Advance(std::uint64_t nowMs);
+
+            std::size_t Pending() const;
+
+            std::uint64_t Frame() const;
+
+        private:
+            static constexpr std::size_t slotCount = 512;  // ~0.5s per turn at 1ms, longer delays wait extra turns
+            static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+            enum class Clock : std::uint8_t { kMs, kFrames };
+
+            struct Timer {
+                    Callback callback;
+                    std::uint64_t deadline = 0;
+                    std::uint64_t sequence = 0;  // Keeps timers with the same deadline in scheduling order
+                    std::uint32_t prev = none;
+                    std::uint32_t next = none;
+                    std::uint32_t generation = 0;
+                    Clock clock = Clock::kMs;
+                    bool active = false;
+            };
+
+            struct Wheel {
+                    std::array<std::uint32_t, slotCount> heads;
+                    std::uint64_t now = 0;
+            };
+
+            Handle Insert(Clock clock, std::uint64_t deadline, Callback &&callback);
+            void Link(Wheel &wheel, std::uint32_t index);
+            void Unlink(Wheel &wheel, std::uint32_t index);
+            void Release(std::uint32_t index);
+            void CollectDue(Wheel &wheel, std::uint64_t now, std::vector<std::uint32_t> &due);
+
+            Wheel &WheelFor(Clock clock) {
+                return clock == Clock::kMs ? msWheel : frameWheel;
+            }
+
+            mutable std::mutex lock;
+            Wheel msWheel;
+            Wheel frameWheel;
+            std::vector<Timer> timers;
+            std::vector<std::uint32_t> freeList;
+            std::vector<std::uint32_t> due;
+            std::uint64_t nextSequence = 0;
+            std::size_t pending = 0;
+    };
+}  // namespace ParkourCore
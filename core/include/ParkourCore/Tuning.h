@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ParkourCore/ScaledThresholds.h"
+
+namespace ParkourCore::Tuning {
+
+    // Unscaled thresholds from an INI style file. Keys not in the file keep their compiled in value.
+    // Unknown keys, bad numbers and out of range counts reject the whole file, so a typo never half applies.
+    //
+    //   [Ledge]
+    //   ForwardStep = 8        ; '#' or ';' start a comment
+    struct File {
+            ScaledThresholds thresholds;
+            bool hotReload = false;  // [General] HotReload, poll the file for changes
+    };
+
+    bool Parse(std::string_view text, File &out, std::string &errorOut);
+    bool LoadFile(const std::filesystem::path &path, File &out, std::string &errorOut);
+
+    // Every key with its current value, in the file format
+    std::string Format(const File &file);
+
+    // Immutable snapshots behind one atomic pointer. Readers pay a single acquire load and never block.
+    // Old snapshots stay alive until the store goes away, reloads are rare and a reader may still hold one.
+    class Store {
+        public:
+            Store();
+
+            const ScaledThresholds &Current() const {
+                return *current.load(std::memory_order_acquire);
+            }
+
+            // Bumped on every Publish, cheap way for caches to notice a reload
+            std::uint32_t Version() const {
+                return version.load(std::memory_order_acquire);
+            }
+
+            void Publish(const ScaledThresholds &thresholds);
+
+        private:
+            std::mutex writeLock;
+            std::vector<std::unique_ptr<const ScaledThresholds>> snapshots;
+            std::atomic<const ScaledThresholds *> current;
+            std::atomic<std::uint32_t> version{0};
+    };
+}  // namespace ParkourCore::Tuning
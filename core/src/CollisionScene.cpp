@@ -0,0 +1,516 @@
+#include "ParkourCore/CollisionScene.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string_view>
+
+namespace ParkourCore {
+
+    namespace {
+        constexpr std::uint32_t maxLeafTriangles = 4;
+        constexpr float epsilon = 1e-7f;
+
+        constexpr std::array<std::string_view, 42> layerNames = {
+            "kUnidentified",  "kStatic",        "kAnimStatic",   "kTransparent",      "kClutter",
+            "kWeapon",        "kProjectile",    "kSpell",        "kBiped",            "kTrees",
+            "kProps",         "kWater",         "kTrigger",      "kTerrain",          "kTrap",
+            "kNonCollidable", "kCloudTrap",     "kGround",       "kPortal",           "kDebrisSmall",
+            "kDebrisLarge",   "kAcousticSpace", "kActorZone",    "kProjectileZone",   "kGasTrap",
+            "kShellCasting",  "kTransparentWall", "kInvisibleWall", "kTransparentSmallAnim", "kClutterLarge",
+            "kCharController", "kStairHelper",  "kDeadBip",      "kBipedNoCC",        "kAvoidBox",
+            "kCollisionBox",  "kCameraSphere",  "kDoorDetection", "kConeProjectile",  "kCamera",
+            "kItemPicker",    "kLOS"};
+
+        bool ParseLayer(std::string_view token, CollisionLayer &out) {
+            for (std::size_t i = 0; i < layerNames.size(); i++) {
+                if (token == layerNames[i] || token == layerNames[i].substr(1)) {
+                    out = static_cast<CollisionLayer>(i);
+                    return true;
+                }
+            }
+            std::uint32_t value = 0;
+            const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+            if (ec != std::errc() || ptr != token.data() + token.size() || value >= layerNames.size()) {
+                return false;
+            }
+            out = static_cast<CollisionLayer>(value);
+            return true;
+        }
+
+        std::string_view LayerName(CollisionLayer layer) {
+            const auto index = static_cast<std::size_t>(layer);
+            return index < layerNames.size() ? layerNames[index] : "kUnidentified";
+        }
+
+        Vec3 Min(const Vec3 &a, const Vec3 &b) {
+            return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
+        }
+        Vec3 Max(const Vec3 &a, const Vec3 &b) {
+            return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+        }
+        float Axis(const Vec3 &v, int axis) {
+            return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+        }
+
+        // Huge but finite, so axis aligned rays lying on a slab plane don't turn into 0 * inf = NaN
+        float SafeInverse(float d) {
+            return 1.0f / (d != 0.0f ? d : 1e-30f);
+        }
+
+        // Slab test against a node's bounds, returns entry distance or infinity
+        float IntersectBounds(const Vec3 &bmin, const Vec3 &bmax, const Vec3 &origin, const Vec3 &invDir, float tMax) {
+            const float tx1 = (bmin.x - origin.x) * invDir.x;
+            const float tx2 = (bmax.x - origin.x) * invDir.x;
+            float tmin = std::min(tx1, tx2);
+            float tmax = std::max(tx1, tx2);
+            const float ty1 = (bmin.y - origin.y) * invDir.y;
+            const float ty2 = (bmax.y - origin.y) * invDir.y;
+            tmin = std::max(tmin, std::min(ty1, ty2));
+            tmax = std::min(tmax, std::max(ty1, ty2));
+            const float tz1 = (bmin.z - origin.z) * invDir.z;
+            const float tz2 = (bmax.z - origin.z) * invDir.z;
+            tmin = std::max(tmin, std::min(tz1, tz2));
+            tmax = std::min(tmax, std::max(tz1, tz2));
+
+            if (tmax >= tmin && tmin < tMax && tmax >= 0.0f) {
+                return tmin;
+            }
+            return std::numeric_limits<float>::infinity();
+        }
+
+        // Moller-Trumbore, front faces only
+        bool IntersectTriangle(const Triangle &tri, const Vec3 &origin, const Vec3 &dir, float tMax, float &tOut) {
+            const Vec3 edge1 = tri.b - tri.a;
+            const Vec3 edge2 = tri.c - tri.a;
+            const Vec3 p = dir.Cross(edge2);
+            const float det = edge1.Dot(p);
+            if (det < epsilon) {
+                return false;  // Back face or parallel
+            }
+            const float invDet = 1.0f / det;
+            const Vec3 s = origin - tri.a;
+            const float u = s.Dot(p) * invDet;
+            if (u < 0.0f || u > 1.0f) {
+                return false;
+            }
+            const Vec3 q = s.Cross(edge1);
+            const float v = dir.Dot(q) * invDet;
+            if (v < 0.0f || u + v > 1.0f) {
+                return false;
+            }
+            const float t = edge2.Dot(q) * invDet;
+            if (t < 0.0f || t >= tMax) {
+                return false;
+            }
+            tOut = t;
+            return true;
+        }
+
+        // Separating axis test of a box moving along dir against a triangle. Every axis gives the span of time in which
+        // the projections overlap, the box touches the triangle while all spans do and enters at the latest span start.
+        // Touching without overlap doesn't count, so a box sliding along a face stays clear.
+        bool SweepTriangle(const Triangle &tri, const Vec3 &center, const Vec3 &halfExtents, const Vec3 &dir, float tMax, float &tOut,
+                           Vec3 &normalOut) {
+            const Vec3 edges[3] = {tri.b - tri.a, tri.c - tri.b, tri.a - tri.c};
+            constexpr Vec3 boxAxes[3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+
+            std::array<Vec3, 13> axes;
+            std::size_t axisCount = 0;
+            for (const auto &axis: boxAxes) {
+                axes[axisCount++] = axis;
+            }
+            axes[axisCount++] = edges[0].Cross(edges[1]);
+            for (const auto &axis: boxAxes) {
+                for (const auto &edge: edges) {
+                    axes[axisCount++] = axis.Cross(edge);
+                }
+            }
+
+            float enter = std::numeric_limits<float>::lowest();
+            float exit = std::numeric_limits<float>::max();
+            Vec3 enterAxis = -dir;
+            for (const auto &axis: axes) {
+                if (axis.Dot(axis) < epsilon) {
+                    continue;  // Edge parallel to a box axis, or a degenerate triangle
+                }
+                const float pa = axis.Dot(tri.a);
+                const float pb = axis.Dot(tri.b);
+                const float pc = axis.Dot(tri.c);
+                const float radius =
+                    halfExtents.x * std::abs(axis.x) + halfExtents.y * std::abs(axis.y) + halfExtents.z * std::abs(axis.z);
+                const float low = std::min(pa, std::min(pb, pc)) - radius;
+                const float high = std::max(pa, std::max(pb, pc)) + radius;
+                const float start = axis.Dot(center);
+                const float speed = axis.Dot(dir);
+
+                if (speed == 0.0f) {
+                    if (start <= low || start >= high) {
+                        return false;  // Separated for the whole sweep
+                    }
+                    continue;
+                }
+                float t0 = (low - start) / speed;
+                float t1 = (high - start) / speed;
+                if (t0 > t1) {
+                    std::swap(t0, t1);
+                }
+                if (t0 > enter) {
+                    enter = t0;
+                    enterAxis = axis;
+                }
+                exit = std::min(exit, t1);
+                if (enter >= exit || enter >= tMax || exit <= 0.0f) {
+                    return false;
+                }
+            }
+
+            tOut = std::max(enter, 0.0f);
+            normalOut = enterAxis * (1.0f / enterAxis.Length());
+            if (normalOut.Dot(dir) > 0.0f) {
+                normalOut = -normalOut;
+            }
+            return true;
+        }
+
+        Vec3 FaceNormal(const Triangle &tri) {
+            const Vec3 n = (tri.b - tri.a).Cross(tri.c - tri.a);
+            const float len = n.Length();
+            return len > 0.0f ? n * (1.0f / len) : Vec3{};
+        }
+    }  // namespace
+
+    void CollisionScene::AddTriangle(const Triangle &tri) {
+        triangles.push_back(tri);
+        Shape shape;
+        shape.tri = tri;
+        shape.layer = tri.layer;
+        shapes.push_back(shape);
+    }
+
+    void CollisionScene::AddBox(const Vec3 &min, const Vec3 &max, CollisionLayer layer) {
+        const Vec3 v[8] = {{min.x, min.y, min.z}, {max.x, min.y, min.z}, {max.x, max.y, min.z}, {min.x, max.y, min.z},
+                           {min.x, min.y, max.z}, {max.x, min.y, max.z}, {max.x, max.y, max.z}, {min.x, max.y, max.z}};
+        // Two counter clockwise triangles per face, normals pointing out
+        constexpr int faces[12][3] = {{0, 2, 1}, {0, 3, 2}, {4, 5, 6}, {4, 6, 7}, {0, 1, 5}, {0, 5, 4},
+                                      {1, 2, 6}, {1, 6, 5}, {2, 3, 7}, {2, 7, 6}, {3, 0, 4}, {3, 4, 7}};
+        for (const auto &f: faces) {
+            triangles.push_back({v[f[0]], v[f[1]], v[f[2]], layer});
+        }
+
+        Shape shape;
+        shape.isBox = true;
+        shape.min = min;
+        shape.max = max;
+        shape.layer = layer;
+        shapes.push_back(shape);
+    }
+
+    void CollisionScene::Clear() {
+        triangles.clear();
+        centroids.clear();
+        nodes.clear();
+        shapes.clear();
+    }
+
+    void CollisionScene::Build() {
+        nodes.clear();
+        centroids.clear();
+        if (triangles.empty()) {
+            return;
+        }
+
+        centroids.reserve(triangles.size());
+        for (const auto &tri: triangles) {
+            centroids.push_back((tri.a + tri.b + tri.c) * (1.0f / 3.0f));
+        }
+
+        nodes.reserve(triangles.size() * 2);
+        Node root;
+        root.leftOrFirst = 0;
+        root.count = static_cast<std::uint32_t>(triangles.size());
+        nodes.push_back(root);
+        UpdateBounds(nodes[0]);
+        Subdivide(0);
+    }
+
+    void CollisionScene::UpdateBounds(Node &node) const {
+        node.min = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        node.max = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+        for (std::uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++) {
+            const auto &tri = triangles[i];
+            node.min = Min(node.min, Min(tri.a, Min(tri.b, tri.c)));
+            node.max = Max(node.max, Max(tri.a, Max(tri.b, tri.c)));
+        }
+    }
+
+    // Median split on the longest centroid axis. Scenes are small, build time doesn't matter, traversal does.
+    void CollisionScene::Subdivide(std::uint32_t nodeIndex) {
+        const std::uint32_t first = nodes[nodeIndex].leftOrFirst;
+        const std::uint32_t count = nodes[nodeIndex].count;
+        if (count <= maxLeafTriangles) {
+            return;
+        }
+
+        Vec3 cmin = centroids[first];
+        Vec3 cmax = centroids[first];
+        for (std::uint32_t i = first; i < first + count; i++) {
+            cmin = Min(cmin, centroids[i]);
+            cmax = Max(cmax, centroids[i]);
+        }
+        const Vec3 extent = cmax - cmin;
+        int axis = 0;
+        if (extent.y > extent.x) {
+            axis = 1;
+        }
+        if (extent.z > Axis(extent, axis)) {
+            axis = 2;
+        }
+        if (Axis(extent, axis) <= 0.0f) {
+            return;  // All centroids coincide, keep as leaf
+        }
+
+        // Sort the triangle range by centroid along the axis, keeping centroids in step
+        std::vector<std::uint32_t> order(count);
+        for (std::uint32_t i = 0; i < count; i++) {
+            order[i] = first + i;
+        }
+        const std::uint32_t half = count / 2;
+        std::nth_element(order.begin(), order.begin() + half, order.end(),
+                         [&](std::uint32_t l, std::uint32_t r) { return Axis(centroids[l], axis) < Axis(centroids[r], axis); });
+
+        std::vector<Triangle> sortedTris;
+        std::vector<Vec3> sortedCentroids;
+        sortedTris.reserve(count);
+        sortedCentroids.reserve(count);
+        for (const auto index: order) {
+            sortedTris.push_back(triangles[index]);
+            sortedCentroids.push_back(centroids[index]);
+        }
+        std::copy(sortedTris.begin(), sortedTris.end(), triangles.begin() + first);
+        std::copy(sortedCentroids.begin(), sortedCentroids.end(), centroids.begin() + first);
+
+        const auto leftIndex = static_cast<std::uint32_t>(nodes.size());
+        Node left;
+        left.leftOrFirst = first;
+        left.count = half;
+        Node right;
+        right.leftOrFirst = first + half;
+        right.count = count - half;
+        UpdateBounds(left);
+        UpdateBounds(right);
+        nodes.push_back(left);
+        nodes.push_back(right);
+
+        nodes[nodeIndex].leftOrFirst = leftIndex;
+        nodes[nodeIndex].count = 0;
+
+        Subdivide(leftIndex);
+        Subdivide(leftIndex + 1);
+    }
+
+    RayHit CollisionScene::CastRay(const Vec3 &origin, const Vec3 &dir, float maxDist) {
+        if (nodes.empty() || maxDist <= 0.0f) {
+            return MakeMiss(maxDist);
+        }
+
+        const Vec3 invDir{SafeInverse(dir.x), SafeInverse(dir.y), SafeInverse(dir.z)};
+        float bestT = maxDist;
+        const Triangle *bestTri = nullptr;
+
+        // Nearest child first, skip anything further than the closest hit so far
+        std::array<std::uint32_t, 64> stack;
+        std::size_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            const Node &node = nodes[stack[--stackSize]];
+            if (IntersectBounds(node.min, node.max, origin, invDir, bestT) == std::numeric_limits<float>::infinity()) {
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (std::uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++) {
+                    float t;
+                    if (IntersectTriangle(triangles[i], origin, dir, bestT, t)) {
+                        bestT = t;
+                        bestTri = &triangles[i];
+                    }
+                }
+                continue;
+            }
+
+            std::uint32_t nearChild = node.leftOrFirst;
+            std::uint32_t farChild = node.leftOrFirst + 1;
+            const float tNear = IntersectBounds(nodes[nearChild].min, nodes[nearChild].max, origin, invDir, bestT);
+            const float tFar = IntersectBounds(nodes[farChild].min, nodes[farChild].max, origin, invDir, bestT);
+            if (tFar < tNear) {
+                std::swap(nearChild, farChild);
+            }
+            const float tFirst = std::min(tNear, tFar);
+            const float tSecond = std::max(tNear, tFar);
+            if (tSecond != std::numeric_limits<float>::infinity() && stackSize < stack.size()) {
+                stack[stackSize++] = farChild;
+            }
+            if (tFirst != std::numeric_limits<float>::infinity() && stackSize < stack.size()) {
+                stack[stackSize++] = nearChild;
+            }
+        }
+
+        if (!bestTri) {
+            return MakeMiss(maxDist);
+        }
+        return MakeHit(maxDist, bestT / maxDist, FaceNormal(*bestTri), bestTri->layer);
+    }
+
+    // Same traversal as CastRay against node bounds grown by the half extents, the box centre moves like a ray through them
+    RayHit CollisionScene::SweepBox(const Vec3 &origin, const Vec3 &halfExtents, const Vec3 &dir, float maxDist) {
+        if (nodes.empty() || maxDist <= 0.0f) {
+            return MakeMiss(maxDist);
+        }
+
+        const Vec3 invDir{SafeInverse(dir.x), SafeInverse(dir.y), SafeInverse(dir.z)};
+        const auto enterNode = [&](const Node &node, float tMax) {
+            return IntersectBounds(node.min - halfExtents, node.max + halfExtents, origin, invDir, tMax);
+        };
+        float bestT = maxDist;
+        Vec3 bestNormal;
+        const Triangle *bestTri = nullptr;
+
+        std::array<std::uint32_t, 64> stack;
+        std::size_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0 && bestT > 0.0f) {
+            const Node &node = nodes[stack[--stackSize]];
+            if (enterNode(node, bestT) == std::numeric_limits<float>::infinity()) {
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (std::uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++) {
+                    float t;
+                    Vec3 normal;
+                    if (SweepTriangle(triangles[i], origin, halfExtents, dir, bestT, t, normal)) {
+                        bestT = t;
+                        bestNormal = normal;
+                        bestTri = &triangles[i];
+                    }
+                }
+                continue;
+            }
+
+            std::uint32_t nearChild = node.leftOrFirst;
+            std::uint32_t farChild = node.leftOrFirst + 1;
+            const float tNear = enterNode(nodes[nearChild], bestT);
+            const float tFar = enterNode(nodes[farChild], bestT);
+            if (tFar < tNear) {
+                std::swap(nearChild, farChild);
+            }
+            const float tFirst = std::min(tNear, tFar);
+            const float tSecond = std::max(tNear, tFar);
+            if (tSecond != std::numeric_limits<float>::infinity() && stackSize < stack.size()) {
+                stack[stackSize++] = farChild;
+            }
+            if (tFirst != std::numeric_limits<float>::infinity() && stackSize < stack.size()) {
+                stack[stackSize++] = nearChild;
+            }
+        }
+
+        if (!bestTri) {
+            return MakeMiss(maxDist);
+        }
+        return MakeHit(maxDist, bestT / maxDist, bestNormal, bestTri->layer);
+    }
+
+    void CollisionScene::CastBatch(RayBatch &batch) {
+        for (std::size_t i = 0; i < batch.Size(); i++) {
+            batch.results[i] = CastRay(batch.Origin(i), batch.Dir(i), batch.MaxDist(i));
+        }
+    }
+
+    bool CollisionScene::Parse(const std::string &text, std::string &errorOut) {
+        std::istringstream input(text);
+        std::string line;
+        int lineNumber = 0;
+
+        while (std::getline(input, line)) {
+            lineNumber++;
+            if (const auto comment = line.find('#'); comment != std::string::npos) {
+                line.erase(comment);
+            }
+
+            std::istringstream tokens(line);
+            std::string kind;
+            if (!(tokens >> kind)) {
+                continue;  // Empty line
+            }
+
+            const int valueCount = kind == "box" ? 6 : kind == "tri" ? 9 : 0;
+            if (valueCount == 0) {
+                errorOut = "line " + std::to_string(lineNumber) + ": unknown shape '" + kind + "'";
+                return false;
+            }
+
+            float v[9] = {};
+            for (int i = 0; i < valueCount; i++) {
+                if (!(tokens >> v[i])) {
+                    errorOut = "line " + std::to_string(lineNumber) + ": expected " + std::to_string(valueCount) + " numbers";
+                    return false;
+                }
+            }
+
+            std::string layerToken;
+            CollisionLayer layer;
+            if (!(tokens >> layerToken) || !ParseLayer(layerToken, layer)) {
+                errorOut = "line " + std::to_string(lineNumber) + ": bad collision layer '" + layerToken + "'";
+                return false;
+            }
+
+            if (kind == "box") {
+                AddBox({v[0], v[1], v[2]}, {v[3], v[4], v[5]}, layer);
+            }
+            else {
+                AddTriangle({{v[0], v[1], v[2]}, {v[3], v[4], v[5]}, {v[6], v[7], v[8]}, layer});
+            }
+        }
+
+        Build();
+        return true;
+    }
+
+    bool CollisionScene::LoadFile(const std::filesystem::path &path, std::string &errorOut) {
+        std::ifstream file(path);
+        if (!file) {
+            errorOut = "can't open " + path.string();
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return Parse(buffer.str(), errorOut);
+    }
+
+    bool CollisionScene::SaveFile(const std::filesystem::path &path) const {
+        std::ofstream file(path);
+        if (!file) {
+            return false;
+        }
+
+        file << "# SkyParkour collision scene: box minX minY minZ maxX maxY maxZ layer | tri ax ay az bx by bz cx cy cz layer\n";
+        for (const auto &shape: shapes) {
+            if (shape.isBox) {
+                file << "box " << shape.min.x << ' ' << shape.min.y << ' ' << shape.min.z << "  " << shape.max.x << ' ' << shape.max.y
+                     << ' ' << shape.max.z << "  " << LayerName(shape.layer) << '\n';
+            }
+            else {
+                const auto &t = shape.tri;
+                file << "tri " << t.a.x << ' ' << t.a.y << ' ' << t.a.z << "  " << t.b.x << ' ' << t.b.y << ' ' << t.b.z << "  " << t.c.x << ' '
+                     << t.c.y << ' ' << t.c.z << "  " << LayerName(shape.layer) << '\n';
+            }
+        }
+        return static_cast<bool>(file);
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,240 @@
+#include "ParkourCore/Detection.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ParkourCore/DetectionSearch.h"
+#include "ParkourCore/QualityTier.h"
+
+namespace ParkourCore {
+
+    namespace {
+        constexpr float ledgeHypotenuse = 1.0;  // 0.75 - larger is more relaxed, lesser is more strict. Don't set 0
+
+        // Step animations need the ledge to be closer than it is high
+        bool IsSteppable(const PlayerState &player, const Vec3 &ledgePoint, float ledgePlayerDiff) {
+            const double horizontalDistance = MagnitudeXY(ledgePoint.x - player.position.x, ledgePoint.y - player.position.y);
+            const double verticalDistance = std::abs(ledgePlayerDiff);
+
+            return horizontalDistance < verticalDistance * ledgeHypotenuse;
+        }
+
+        // The one runtime branch on the tier, into a loop compiled for its counts. Custom runs the runtime loop.
+        template <class Unrolled, class Runtime>
+        bool ForQuality(int quality, Unrolled &&unrolled, Runtime &&runtime) {
+            switch (quality) {
+                case DetectionQuality::Low:
+                    return unrolled(TierSpec<DetectionQuality::Low>{});
+                case DetectionQuality::Medium:
+                    return unrolled(TierSpec<DetectionQuality::Medium>{});
+                case DetectionQuality::High:
+                    return unrolled(TierSpec<DetectionQuality::High>{});
+                default:
+                    return runtime();
+            }
+        }
+    }  // namespace
+
+    int ClassifyLedge(const PlayerState &player, const ScaledThresholds &thresholds, const Vec3 &ledgePoint) {
+        const float ledgePlayerDiff = ledgePoint.z - player.position.z;
+
+        if (player.isGroundedOrSliding || player.isSwimming) {
+            if (ledgePlayerDiff >= thresholds.highestLedgeLimit) {
+                if (player.shouldReplaceWithFailed) {
+                    return ParkourType::Failed;
+                }
+                return ParkourType::Highest;  // Highest ledge
+            }
+            else if (ledgePlayerDiff >= thresholds.highLedgeLimit) {
+                if (player.shouldReplaceWithFailed) {
+                    return ParkourType::Failed;
+                }
+                return ParkourType::High;  // High ledge
+            }
+            else if (ledgePlayerDiff >= thresholds.medLedgeLimit) {
+                return ParkourType::Medium;  // Medium ledge
+            }
+            else if (ledgePlayerDiff >= thresholds.lowLedgeLimit) {
+                if (player.isSwimming) {
+                    return ParkourType::Grab;  // Grab ledge out of water, don't jump out like a frog
+                }
+
+                return ParkourType::Low;  // Low ledge
+            }
+            else if (ledgePlayerDiff >= thresholds.highStepLimit) {
+                if (player.isSwimming) {
+                    return ParkourType::Grab;  // Grab ledge out of water, don't step out
+                }
+
+                if (IsSteppable(player, ledgePoint, ledgePlayerDiff)) {
+                    return ParkourType::StepHigh;  // High Step
+                }
+            }
+            else {
+                if (player.isSwimming) {
+                    return ParkourType::Grab;  // Grab ledge out of water, don't step out
+                }
+
+                if (!player.isOnStairs && IsSteppable(player, ledgePoint, ledgePlayerDiff)) {
+                    return ParkourType::StepLow;  // Low Step
+                }
+            }
+        }
+        else if (player.isMidairAndNotSliding && ledgePlayerDiff > -35 && ledgePlayerDiff <= thresholds.grabMaxHeight) {
+            if (!player.isOnStairs) {
+                return ParkourType::Grab;
+            }
+        }
+        return ParkourType::NoLedge;
+    }
+
+    bool FindLedge(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, Vec3 &ledgePoint, const Vec3 &checkDir,
+                   float minLedgeHeight, float maxLedgeHeight) {
+        const Vec3 playerPos = player.position;
+
+        const float startZOffset = thresholds.ledgeStartZOffset;
+        const float playerHeight = thresholds.standingHeight;
+        const float minUpCheck = thresholds.ledgeMinUpCheck;
+        const float maxUpCheck = (maxLedgeHeight - startZOffset) + thresholds.ledgeUpCheckMargin;
+
+        // Upward raycast to check for headroom
+        const Vec3 upRayStart = playerPos + Vec3(0, 0, startZOffset);
+        const Vec3 upRayDir(0, 0, 1);
+
+        const float upRayDist = world.CastRay(upRayStart, upRayDir, maxUpCheck).distance;
+        if (upRayDist < minUpCheck) {
+            return false;
+        }
+
+        // Forward raycast initialization
+        const Vec3 fwdRayStart = upRayStart + upRayDir * (upRayDist - 10);
+        const ForwardSearch search{world, thresholds, playerPos, fwdRayStart, checkDir, startZOffset + maxUpCheck, minLedgeHeight,
+                                   maxLedgeHeight};
+
+        // Incremental forward raycast to find a ledge
+        bool foundLedge = false;
+        if (thresholds.ledgeForwardSearch == ProbeSearch::Adaptive) {
+            foundLedge = search.Adaptive(ledgePoint);
+        }
+        else {
+            const auto unrolled = [&]<class Spec>(Spec) { return search.template LinearUnrolled<Spec::ledgeForwardIterations>(ledgePoint); };
+            foundLedge = ForQuality(thresholds.quality, unrolled, [&] { return search.Linear(ledgePoint); });
+        }
+
+        if (!foundLedge) {
+            return false;
+        }
+
+        // Ensure there is sufficient headroom for the player to stand
+        const float headroomBuffer = thresholds.headroomBuffer;
+        const Vec3 headroomRayStart = ledgePoint + upRayDir * headroomBuffer;
+        const float headroomLength = playerHeight - headroomBuffer;
+        const Vec3 columnHalfExtents(thresholds.clearanceRadius, thresholds.clearanceRadius, 0);
+        const float headroomRayDist = thresholds.ledgeClearance == ClearanceCheck::Sweep
+                                          ? world.SweepBox(headroomRayStart, columnHalfExtents, upRayDir, headroomLength).distance
+                                          : world.CastRay(headroomRayStart, upRayDir, headroomLength).distance;
+
+        if (headroomRayDist < headroomLength) {
+            return false;
+        }
+
+        return true;
+    }
+
+    int LedgeCheck(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, Vec3 &ledgePoint,
+                   const Vec3 &checkDir, float minLedgeHeight, float maxLedgeHeight) {
+        if (!FindLedge(world, player, thresholds, ledgePoint, checkDir, minLedgeHeight, maxLedgeHeight)) {
+            return ParkourType::NoLedge;
+        }
+        return ClassifyLedge(player, thresholds, ledgePoint);
+    }
+
+    int VaultCheck(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, Vec3 &ledgePoint,
+                   const Vec3 &checkDir, float vaultLength, float maxElevationIncrease, float minVaultHeight, float maxVaultHeight) {
+        if (!player.isGroundedOrSliding) {
+            return ParkourType::NoLedge;
+        }
+
+        const Vec3 playerPos = player.position;
+        const float headHeight = thresholds.vaultHeadHeight;
+
+        // Forward raycast to check for a vaultable surface
+        const Vec3 fwdRayStart = playerPos + Vec3(0, 0, headHeight);
+        const RayHit fwdHit = world.CastRay(fwdRayStart, checkDir, vaultLength);
+        const float fwdRayDist = fwdHit.distance;
+
+        if (fwdHit.layer == CollisionLayer::kTerrain || fwdRayDist < vaultLength) {
+            return ParkourType::NoLedge;  // Not vaultable if terrain or insufficient distance
+        }
+
+        // Backward ray to check for obstructions behind the vaultable surface
+        const Vec3 backwardRayStart = fwdRayStart + checkDir * (fwdRayDist - 2) + Vec3(0, 0, 5);
+        const float maxObstructionDistance = thresholds.vaultObstructionDist;
+        const float backwardRayDist = world.CastRay(backwardRayStart, checkDir, maxObstructionDistance).distance;
+
+        if (backwardRayDist > 0 && backwardRayDist < maxObstructionDistance) {
+            return ParkourType::NoLedge;  // Obstruction behind the vaultable surface
+        }
+
+        // Downward raycasts for the obstacle top and the landing behind it
+        VaultSearch search{world, thresholds, playerPos, checkDir, fwdRayStart.z, minVaultHeight, maxVaultHeight, maxElevationIncrease};
+        const auto unrolled = [&]<class Spec>(Spec) { return search.template LinearUnrolled<Spec::vaultDownIterations>(ledgePoint); };
+        const bool foundVault = ForQuality(thresholds.quality, unrolled, [&] { return search.Linear(ledgePoint); });
+
+        // Final validation for vault
+        if (foundVault) {
+            ledgePoint.z = playerPos.z + search.foundVaultHeight;
+            if (!player.isOnStairs) {
+                return ParkourType::Vault;  // Vault successful
+            }
+        }
+
+        return ParkourType::NoLedge;  // Vault failed
+    }
+
+    DetectionResult GetLedgePoint(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, bool smartParkour) {
+        const Vec3 playerDirFlat = DirFlatFromYaw(player.yaw);
+
+        // Perform ledge or vault checks
+        int selectedLedgeType = ParkourType::NoLedge;
+        Vec3 ledgePoint;
+
+        if (player.isMoving || !smartParkour) {
+            selectedLedgeType = VaultCheck(world, player, thresholds, ledgePoint, playerDirFlat, thresholds.vaultLength,
+                                           thresholds.vaultMaxElevationIncrease, thresholds.vaultMinHeight, thresholds.vaultMaxHeight);
+        }
+
+        if (selectedLedgeType == ParkourType::NoLedge) {
+            selectedLedgeType = LedgeCheck(world, player, thresholds, ledgePoint, playerDirFlat, thresholds.climbMinHeight,
+                                           thresholds.climbMaxHeight);
+        }
+        return MakeDetectionResult(player, thresholds, playerDirFlat, selectedLedgeType, ledgePoint);
+    }
+
+    // Up, forward, face and a Linear fallback with three casts per probe plus headroom for the ledge check. Forward,
+    // backward, the face ray and every down sample for the vault check.
+    int MaxCastsPerDecision(const ScaledThresholds &thresholds) {
+        const int ledge = 4 + 3 * thresholds.ledgeForwardIterations;
+        const int vault = 3 + std::min(thresholds.vaultDownIterations, static_cast<int>(RayBatch::kCapacity));
+        return ledge + vault;
+    }
+
+    DetectionResult MakeDetectionResult(const PlayerState &player, const ScaledThresholds &thresholds, const Vec3 &playerDirFlat,
+                                        int ledgeType, const Vec3 &ledgePoint) {
+        if (ledgeType == ParkourType::NoLedge) {
+            return {};
+        }
+
+        // Don't ever parkour into water, last check before saying this ledge is valid
+        if (ledgePoint.z < player.waterHeight - 10) {
+            return {};
+        }
+
+        DetectionResult result;
+        result.ledgeType = ledgeType;
+        result.ledgePoint = ledgePoint;
+        result.playerDirFlat = playerDirFlat;
+        result.backwardAdjustment = playerDirFlat * thresholds.backwardOffset;
+        return result;
+    }
+}  // namespace ParkourCore
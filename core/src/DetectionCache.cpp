@@ -0,0 +1,119 @@
+#include "ParkourCore/DetectionCache.h"
+
+#include "ParkourCore/CountingWorldQuery.h"
+
+namespace ParkourCore {
+
+    DetectionKey DetectionCache::MakeKey(const PlayerState &player, bool smartParkour) const {
+        DetectionKey key;
+        key.position = player.position;
+        key.yaw = player.yaw;
+        key.waterHeight = player.waterHeight;
+        key.scale = player.scale;
+        key.flags = static_cast<std::uint8_t>(player.isMoving << 0 | player.isGroundedOrSliding << 1 | player.isMidairAndNotSliding << 2 |
+                                              player.isSwimming << 3 | player.isOnStairs << 4 | player.shouldReplaceWithFailed << 5 |
+                                              smartParkour << 6);
+        return key;
+    }
+
+    void DetectionCache::SetContext(std::uint32_t cellId, float scale) {
+        negative.SetContext(cellId, scale);
+        if (cellId != cell || scale != contextScale) {
+            cell = cellId;
+            contextScale = scale;
+            Invalidate();
+        }
+    }
+
+    void DetectionCache::Invalidate() {
+        for (auto &entry: entries) {
+            entry.valid = false;
+        }
+        stats.invalidations++;
+        negative.Invalidate();
+    }
+
+    const DetectionResult *DetectionCache::Find(const DetectionKey &key, std::uint64_t nowMs) {
+        stats.lookups++;
+        for (auto &entry: entries) {
+            if (!entry.valid || !(entry.key == key)) {
+                continue;
+            }
+            if (nowMs - entry.storedMs > config.ttlMs) {
+                entry.valid = false;
+                return nullptr;
+            }
+            stats.hits++;
+            stats.raysSaved += entry.rays;
+            return &entry.result;
+        }
+        return nullptr;
+    }
+
+    void DetectionCache::Store(const DetectionKey &key, const DetectionResult &result, std::uint64_t rays, std::uint64_t nowMs) {
+        // Overwrite the same key if present, else the oldest slot
+        Entry *target = nullptr;
+        for (auto &entry: entries) {
+            if (entry.valid && entry.key == key) {
+                target = &entry;
+                break;
+            }
+        }
+        if (!target) {
+            target = &entries[nextSlot];
+            nextSlot = (nextSlot + 1) % entryCount;
+        }
+
+        target->key = key;
+        target->result = result;
+        target->rays = rays;
+        target->storedMs = nowMs;
+        target->valid = true;
+        stats.raysCast += rays;
+    }
+
+    std::optional<DetectionResult> DetectionCache::Answer(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds,
+                                                          bool smartParkour, std::uint64_t nowMs) {
+        if (const auto cached = Find(MakeKey(player, smartParkour), nowMs)) {
+            return *cached;
+        }
+
+        if (thresholds.negativeCache != NegativeCacheMode::Off &&
+            negative.Check(world, player, thresholds, negative.MakeKey(player, smartParkour), nowMs)) {
+            return DetectionResult{};
+        }
+        return std::nullopt;
+    }
+
+    void DetectionCache::Remember(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, bool smartParkour,
+                                  const DetectionResult &result, std::uint64_t rays, std::uint64_t nowMs) {
+        Store(MakeKey(player, smartParkour), result, rays, nowMs);
+
+        if (thresholds.negativeCache != NegativeCacheMode::Off) {
+            const auto negativeKey = negative.MakeKey(player, smartParkour);
+            if (result.ledgeType == ParkourType::NoLedge) {
+                negative.Store(world, player, thresholds, negativeKey, rays, nowMs);
+            }
+            else {
+                negative.Erase(negativeKey);
+            }
+        }
+    }
+
+    DetectionResult DetectionCache::GetLedgePoint(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds,
+                                                  bool smartParkour, std::uint64_t nowMs) {
+        if (const auto answer = Answer(world, player, thresholds, smartParkour, nowMs)) {
+            return *answer;
+        }
+
+        CountingWorldQuery counter(world);
+        const auto result = ParkourCore::GetLedgePoint(counter, player, thresholds, smartParkour);
+        Remember(world, player, thresholds, smartParkour, result, counter.rays, nowMs);
+        return result;
+    }
+
+    void DetectionCache::SetConfig(const DetectionCacheConfig &a_config) {
+        config = a_config;
+        Invalidate();
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,495 @@
+#include "ParkourCore/DetectionJob.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace ParkourCore {
+
+    // What is left of one Step's budget
+    class DetectionJob::Slice {
+        public:
+            explicit Slice(const SliceBudget &a_budget)
+                : budget(a_budget),
+                  start(std::chrono::steady_clock::now()) {}
+
+            // Casts the slice may still make, 0 once it is spent. The first cast is always allowed.
+            std::size_t Room() const {
+                constexpr std::size_t unlimited = RayBatch::kCapacity;
+                if (cast > 0) {
+                    const bool overCasts = budget.casts > 0 && cast >= budget.casts;
+                    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+                    const bool overTime = budget.microseconds > 0 && elapsed.count() >= static_cast<std::int64_t>(budget.microseconds);
+                    if (overCasts || overTime) {
+                        return 0;
+                    }
+                }
+                return budget.casts > 0 ? static_cast<std::size_t>(budget.casts - cast) : unlimited;
+            }
+
+            void Spend(std::size_t n) {
+                cast += static_cast<int>(n);
+            }
+            int Cast() const {
+                return cast;
+            }
+
+        private:
+            SliceBudget budget;
+            std::chrono::steady_clock::time_point start;
+            int cast = 0;
+    };
+
+    void DetectionJob::Start(const PlayerState &a_player, const ScaledThresholds &a_thresholds, bool a_smartParkour) {
+        if (state == State::Running) {
+            stats.abandoned++;
+        }
+        player = a_player;
+        thresholds = a_thresholds;
+        smartParkour = a_smartParkour;
+        checkDir = DirFlatFromYaw(player.yaw);
+        ledgePoint = {};
+        result = {};
+        state = State::Running;
+        frames = 0;
+        casts = 0;
+
+        // Vault first, then climb. Smart parkour skips vaulting while standing still.
+        if ((player.isMoving || !smartParkour) && player.isGroundedOrSliding) {
+            Request(Stage::VaultForward, player.position + Vec3(0, 0, thresholds.vaultHeadHeight), checkDir, thresholds.vaultLength);
+        }
+        else {
+            BeginLedge();
+        }
+    }
+
+    bool DetectionJob::Step(WorldQuery &world, const SliceBudget &budget) {
+        if (state != State::Running) {
+            return state == State::Done;
+        }
+
+        Slice slice(budget);
+        for (std::size_t room = slice.Room(); stage != Stage::Done && room > 0; room = slice.Room()) {
+            CastPending(world, slice, room);
+            if (pendingCast == pending.Size()) {
+                Advance(world);
+            }
+        }
+        frames++;
+        stats.slices++;
+        stats.casts += static_cast<std::uint64_t>(slice.Cast());
+        stats.maxSliceCasts = std::max(stats.maxSliceCasts, static_cast<std::uint32_t>(slice.Cast()));
+        if (stage != Stage::Done) {
+            return false;
+        }
+
+        state = State::Done;
+        stats.decisions++;
+        stats.maxFrames = std::max(stats.maxFrames, frames);
+        return true;
+    }
+
+    const DetectionResult &DetectionJob::Finish(WorldQuery &world) {
+        if (state == State::Running) {
+            stats.forced += frames > 0;
+            Step(world, {});
+        }
+        return result;
+    }
+
+    void DetectionJob::Reset() {
+        if (state == State::Running) {
+            stats.abandoned++;
+        }
+        stage = Stage::Done;
+        result = {};
+        state = State::Idle;
+        frames = 0;
+        casts = 0;
+    }
+
+    ForwardSearch DetectionJob::Forward(WorldQuery &world) const {
+        const float maxUpCheck = (thresholds.climbMaxHeight - thresholds.ledgeStartZOffset) + thresholds.ledgeUpCheckMargin;
+        return {world,
+                thresholds,
+                player.position,
+                fwdRayStart,
+                checkDir,
+                thresholds.ledgeStartZOffset + maxUpCheck,
+                thresholds.climbMinHeight,
+                thresholds.climbMaxHeight};
+    }
+
+    VaultSearch DetectionJob::Vault(WorldQuery &world) const {
+        return {world,
+                thresholds,
+                player.position,
+                checkDir,
+                player.position.z + thresholds.vaultHeadHeight,
+                thresholds.vaultMinHeight,
+                thresholds.vaultMaxHeight,
+                thresholds.vaultMaxElevationIncrease};
+    }
+
+    void DetectionJob::Request(Stage next, const Vec3 &origin, const Vec3 &dir, float maxDist) {
+        pending.Clear();
+        pending.Add(origin, dir, maxDist);
+        pendingCast = 0;
+        pendingSingle = true;
+        pendingSweep = false;
+        stage = next;
+    }
+
+    void DetectionJob::RequestSweep(Stage next, const Vec3 &origin, const Vec3 &halfExtents, const Vec3 &dir, float maxDist) {
+        Request(next, origin, dir, maxDist);
+        pendingSweep = true;
+        pendingHalfExtents = halfExtents;
+    }
+
+    // The clearance check decides between a ray and a box sweep the same way ForwardSearch::CastClearance does
+    void DetectionJob::RequestClearance(Stage next, const ForwardSearch &search, float fwdRayDist) {
+        const Vec3 origin = search.ClearanceStart(fwdRayDist);
+        if (thresholds.ledgeClearance == ClearanceCheck::Sweep) {
+            const Vec3 halfExtents(thresholds.clearanceRadius, thresholds.clearanceRadius, 0);
+            RequestSweep(next, origin, halfExtents, checkDir, thresholds.ledgeObstructionDist);
+        }
+        else {
+            Request(next, origin, checkDir, thresholds.ledgeObstructionDist);
+        }
+    }
+
+    void DetectionJob::CastPending(WorldQuery &world, Slice &slice, std::size_t room) {
+        if (pendingSingle) {
+            const Vec3 origin = pending.Origin(0);
+            pending.results[0] = pendingSweep ? world.SweepBox(origin, pendingHalfExtents, pending.Dir(0), pending.MaxDist(0))
+                                              : world.CastRay(origin, pending.Dir(0), pending.MaxDist(0));
+            pendingCast = 1;
+            slice.Spend(1);
+            casts++;
+            return;
+        }
+
+        const std::size_t n = std::min(room, pending.Size() - pendingCast);
+        if (n == pending.Size()) {
+            world.CastBatch(pending);
+        }
+        else {
+            // As much of the batch as the budget allows, the rest goes out in the next slice
+            RayBatch part;
+            for (std::size_t i = pendingCast; i < pendingCast + n; i++) {
+                part.Add(pending.Origin(i), pending.Dir(i), pending.MaxDist(i));
+            }
+            world.CastBatch(part);
+            std::copy_n(part.results.begin(), n, pending.results.begin() + static_cast<std::ptrdiff_t>(pendingCast));
+            stats.splitBatches += pendingCast == 0;
+        }
+        pendingCast += n;
+        slice.Spend(n);
+        casts += n;
+    }
+
+    // Takes the finished cast's result to the check it belongs to, which decides or asks for the next cast
+    void DetectionJob::Advance(WorldQuery &world) {
+        const RayHit hit = pending.results[0];
+        const Vec3 down(0, 0, -1);
+
+        switch (stage) {
+            case Stage::VaultForward:
+                if (hit.layer == CollisionLayer::kTerrain || hit.distance < thresholds.vaultLength) {
+                    BeginLedge();  // Not vaultable if terrain or insufficient distance
+                    break;
+                }
+                Request(Stage::VaultBackward, pending.Origin(0) + checkDir * (hit.distance - 2) + Vec3(0, 0, 5), checkDir,
+                        thresholds.vaultObstructionDist);
+                break;
+
+            case Stage::VaultBackward: {
+                if (hit.distance > 0 && hit.distance < thresholds.vaultObstructionDist) {
+                    BeginLedge();  // Obstruction behind the vaultable surface
+                    break;
+                }
+                const auto search = Vault(world);
+                pending.Clear();
+                for (int i = 0; i < search.Iterations(); i++) {
+                    pending.Add(search.SampleOrigin(i), down, search.DownLength());
+                }
+                pendingCast = 0;
+                pendingSingle = false;
+                pendingSweep = false;
+                stage = Stage::VaultDown;
+                break;
+            }
+
+            case Stage::VaultDown: {
+                auto search = Vault(world);
+                bool folded = true;
+                for (std::size_t i = 0; folded && i < pending.Size(); i++) {
+                    folded = search.Fold(pending.Origin(i), pending.results[i].distance, ledgePoint);
+                }
+                if (folded && search.Confirmed() && !player.isOnStairs) {
+                    ledgePoint.z = player.position.z + search.foundVaultHeight;
+                    Decide(ParkourType::Vault);
+                    break;
+                }
+                BeginLedge();
+                break;
+            }
+
+            case Stage::LedgeUp: {
+                if (hit.distance < thresholds.ledgeMinUpCheck) {
+                    Decide(ParkourType::NoLedge);
+                    break;
+                }
+                fwdRayStart = pending.Origin(0) + Vec3(0, 0, hit.distance - 10);
+                BeginForwardSearch(world);
+                break;
+            }
+
+            case Stage::ProbeForward: {
+                const auto search = Forward(world);
+                if (hit.distance < search.ProbeDistance(probe)) {
+                    BeginProbe(world, probe + 1);
+                    break;
+                }
+                probeFwdDist = hit.distance;
+                Request(Stage::ProbeDown, search.DownRayStart(hit.distance), down, search.downRayLength);
+                break;
+            }
+
+            case Stage::ProbeDown: {
+                const auto search = Forward(world);
+                ledgePoint = pending.Origin(0) + down * hit.distance;
+                if (!search.InBand(hit, ledgePoint)) {
+                    BeginProbe(world, probe + 1);
+                    break;
+                }
+                RequestClearance(Stage::ProbeClearance, search, probeFwdDist);
+                break;
+            }
+
+            case Stage::ProbeClearance:
+                if (Forward(world).Clear(hit.distance)) {
+                    BeginHeadroom();
+                }
+                else {
+                    BeginProbe(world, probe + 1);
+                }
+                break;
+
+            case Stage::AdaptiveForward: {
+                const auto search = Forward(world);
+                const int iterations = std::min(thresholds.ledgeForwardIterations, ForwardSearch::maxIterations);
+                const float reach = search.ProbeDistance(iterations - 1);
+                if (hit.distance < 0) {
+                    probeEnd = thresholds.ledgeForwardIterations;  // Non parkour layer, distance unknown, Linear
+                    BeginProbe(world, 0);
+                    break;
+                }
+                adaptiveLast = iterations - 1;
+                while (adaptiveLast > 0 && search.ProbeDistance(adaptiveLast) > hit.distance) {
+                    adaptiveLast--;
+                }
+
+                Vec3 lowRayStart = fwdRayStart;
+                lowRayStart.z = player.position.z + thresholds.climbMinHeight - 1;
+                Request(Stage::AdaptiveFace, lowRayStart, checkDir, reach);
+                break;
+            }
+
+            case Stage::AdaptiveFace: {
+                const auto search = Forward(world);
+                const int iterations = std::min(thresholds.ledgeForwardIterations, ForwardSearch::maxIterations);
+                const float reach = search.ProbeDistance(iterations - 1);
+                if (hit.distance < 0) {
+                    probeEnd = thresholds.ledgeForwardIterations;
+                    BeginProbe(world, 0);
+                    break;
+                }
+
+                candidates.fill({});
+                notOnTop = -1;
+                edge = adaptiveLast;
+                if (hit.distance < reach) {
+                    adaptiveFirst = 0;
+                    while (adaptiveFirst < adaptiveLast && search.ProbeDistance(adaptiveFirst) < hit.distance) {
+                        adaptiveFirst++;
+                    }
+                    adaptivePhase = AdaptivePhase::First;
+                }
+                else {
+                    adaptivePhase = AdaptivePhase::Scan;
+                }
+                ContinueAdaptive(world);
+                break;
+            }
+
+            case Stage::AdaptiveDown:
+                candidates[adaptiveProbe] = {true, hit, pending.Origin(0) + down * hit.distance};
+                ContinueAdaptive(world);
+                break;
+
+            case Stage::AdaptiveClearance:
+                if (Forward(world).Clear(hit.distance)) {
+                    ledgePoint = candidates[edge].point;
+                    BeginHeadroom();
+                    break;
+                }
+                edge++;
+                ContinueAdaptive(world);
+                break;
+
+            case Stage::Headroom:
+                if (hit.distance < thresholds.standingHeight - thresholds.headroomBuffer) {
+                    Decide(ParkourType::NoLedge);
+                }
+                else {
+                    Decide(ClassifyLedge(player, thresholds, ledgePoint));
+                }
+                break;
+
+            case Stage::Done:
+                break;
+        }
+    }
+
+    void DetectionJob::BeginLedge() {
+        const float maxUpCheck = (thresholds.climbMaxHeight - thresholds.ledgeStartZOffset) + thresholds.ledgeUpCheckMargin;
+        Request(Stage::LedgeUp, player.position + Vec3(0, 0, thresholds.ledgeStartZOffset), Vec3(0, 0, 1), maxUpCheck);
+    }
+
+    void DetectionJob::BeginForwardSearch(WorldQuery &world) {
+        if (thresholds.ledgeForwardSearch == ProbeSearch::Adaptive) {
+            const int iterations = std::min(thresholds.ledgeForwardIterations, ForwardSearch::maxIterations);
+            Request(Stage::AdaptiveForward, fwdRayStart, checkDir, Forward(world).ProbeDistance(iterations - 1));
+            return;
+        }
+        probeEnd = thresholds.ledgeForwardIterations;
+        BeginProbe(world, 0);
+    }
+
+    void DetectionJob::BeginProbe(WorldQuery &world, int i) {
+        probe = i;
+        if (probe < probeEnd) {
+            Request(Stage::ProbeForward, fwdRayStart, checkDir, Forward(world).ProbeDistance(probe));
+        }
+        else {
+            Decide(ParkourType::NoLedge);
+        }
+    }
+
+    // ForwardSearch::Adaptive with every down ray a stage. Each phase asks for the candidate it needs next and
+    // carries on from the same place once it is in.
+    void DetectionJob::ContinueAdaptive(WorldQuery &world) {
+        const auto search = Forward(world);
+        const auto onTop = [&](int i) { return candidates[i].point.z >= player.position.z + thresholds.climbMinHeight; };
+
+        for (;;) {
+            switch (adaptivePhase) {
+                case AdaptivePhase::First:
+                    if (NeedCandidate(search, adaptiveFirst)) {
+                        return;
+                    }
+                    if (onTop(adaptiveFirst)) {
+                        edge = adaptiveFirst;
+                        notOnTop = adaptiveFirst - 1;
+                        adaptivePhase = AdaptivePhase::Bisect;
+                    }
+                    else if (adaptiveFirst == adaptiveLast) {
+                        Decide(ParkourType::NoLedge);
+                        return;
+                    }
+                    else {
+                        adaptivePhase = AdaptivePhase::Last;
+                    }
+                    break;
+
+                case AdaptivePhase::Last:
+                    if (NeedCandidate(search, adaptiveLast)) {
+                        return;
+                    }
+                    if (!onTop(adaptiveLast)) {
+                        Decide(ParkourType::NoLedge);
+                        return;
+                    }
+                    notOnTop = adaptiveFirst;
+                    adaptivePhase = AdaptivePhase::Bisect;
+                    break;
+
+                case AdaptivePhase::Scan:
+                    // No face, down rays at every probe until one is on top
+                    while (notOnTop < adaptiveLast) {
+                        if (NeedCandidate(search, notOnTop + 1)) {
+                            return;
+                        }
+                        if (onTop(notOnTop + 1)) {
+                            break;
+                        }
+                        notOnTop++;
+                    }
+                    if (notOnTop == adaptiveLast) {
+                        Decide(ParkourType::NoLedge);  // Open ground
+                        return;
+                    }
+                    edge = notOnTop + 1;
+                    adaptivePhase = AdaptivePhase::Bisect;
+                    break;
+
+                case AdaptivePhase::Bisect:
+                    while (edge - notOnTop > 1) {
+                        const int mid = notOnTop + (edge - notOnTop) / 2;
+                        if (NeedCandidate(search, mid)) {
+                            return;
+                        }
+                        if (onTop(mid)) {
+                            edge = mid;
+                        }
+                        else {
+                            notOnTop = mid;
+                        }
+                    }
+                    adaptivePhase = AdaptivePhase::Validate;
+                    break;
+
+                case AdaptivePhase::Validate:
+                    // edge walks the candidates from the first on top
+                    for (; edge <= adaptiveLast; edge++) {
+                        if (NeedCandidate(search, edge)) {
+                            return;
+                        }
+                        if (search.InBand(candidates[edge].downHit, candidates[edge].point)) {
+                            RequestClearance(Stage::AdaptiveClearance, search, search.ProbeDistance(edge));
+                            return;
+                        }
+                    }
+                    Decide(ParkourType::NoLedge);
+                    return;
+            }
+        }
+    }
+
+    bool DetectionJob::NeedCandidate(const ForwardSearch &search, int i) {
+        if (candidates[i].probed) {
+            return false;
+        }
+        adaptiveProbe = i;
+        Request(Stage::AdaptiveDown, search.DownRayStart(search.ProbeDistance(i)), Vec3(0, 0, -1), search.downRayLength);
+        return true;
+    }
+
+    void DetectionJob::BeginHeadroom() {
+        const Vec3 up(0, 0, 1);
+        const Vec3 headroomRayStart = ledgePoint + up * thresholds.headroomBuffer;
+        const float headroomLength = thresholds.standingHeight - thresholds.headroomBuffer;
+        if (thresholds.ledgeClearance == ClearanceCheck::Sweep) {
+            RequestSweep(Stage::Headroom, headroomRayStart, Vec3(thresholds.clearanceRadius, thresholds.clearanceRadius, 0), up,
+                         headroomLength);
+        }
+        else {
+            Request(Stage::Headroom, headroomRayStart, up, headroomLength);
+        }
+    }
+
+    void DetectionJob::Decide(int ledgeType) {
+        result = MakeDetectionResult(player, thresholds, checkDir, ledgeType, ledgePoint);
+        stage = Stage::Done;
+    }
+}  // namespace ParkourCore
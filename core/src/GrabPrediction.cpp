@@ -0,0 +1,182 @@
+#include "ParkourCore/GrabPrediction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ParkourCore {
+
+    Vec3 PredictedGrab::PathPosition(float seconds) const {
+        const float steps = std::max(seconds, 0.0f) / grabPredictionStep;
+        const int i = static_cast<int>(steps);
+        if (i >= pathSteps) {
+            return path[pathSteps];
+        }
+        const float f = steps - static_cast<float>(i);
+        return path[i] + (path[i + 1] - path[i]) * f;
+    }
+
+    PredictedGrab PredictGrab(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds) {
+        PredictedGrab prediction;
+        prediction.path[0] = player.position;
+        if (!player.isMidairAndNotSliding || player.isOnStairs) {
+            return prediction;
+        }
+
+        const int steps = std::clamp(static_cast<int>(std::ceil(thresholds.grabHorizon / grabPredictionStep)), 1, maxGrabPathSteps);
+        const float dt = grabPredictionStep;
+        const float gravity = thresholds.grabGravity;
+        const Vec3 halfExtents(thresholds.clearanceRadius, thresholds.clearanceRadius, thresholds.standingHeight * 0.5f);
+        const Vec3 bodyCenter(0, 0, thresholds.standingHeight * 0.5f + 1.0f);  // Lifted so feet on a floor don't count as a hit
+
+        Vec3 position = player.position;
+        Vec3 velocity = player.velocity;
+        int contactStep = -1;
+        int k = 0;
+        while (k < steps) {
+            const Vec3 next = position + velocity * dt + Vec3(0, 0, -0.5f * gravity * dt * dt);
+            velocity.z -= gravity * dt;
+
+            const Vec3 move = next - position;
+            const float length = move.Length();
+            if (length <= 0.0f) {
+                prediction.path[++k] = position;
+                continue;
+            }
+
+            const Vec3 dir = move * (1.0f / length);
+            const RayHit hit = world.SweepBox(position + bodyCenter, halfExtents, dir, length);
+            if (hit.distance >= length) {
+                position = next;
+                prediction.path[++k] = position;
+                continue;
+            }
+
+            // Blocked, non parkour layers (-1) included. Stop just short of the contact.
+            position = position + dir * std::max(hit.distance - 0.5f, 0.0f);
+            prediction.path[++k] = position;
+            if (hit.normal.z > 0.7f) {
+                break;  // Landed
+            }
+            if (hit.normal.z < -0.7f) {
+                velocity.z = std::min(velocity.z, 0.0f);  // Head against a ceiling
+                continue;
+            }
+            if (velocity.x == 0.0f && velocity.y == 0.0f) {
+                break;  // Already sliding down a wall and still blocked, stuck
+            }
+            velocity.x = 0.0f;
+            velocity.y = 0.0f;
+            if (contactStep < 0) {
+                contactStep = k;
+            }
+        }
+        prediction.pathSteps = k;
+
+        float lowest = std::numeric_limits<float>::max();
+        float highest = std::numeric_limits<float>::lowest();
+        for (int i = 0; i <= prediction.pathSteps; i++) {
+            lowest = std::min(lowest, prediction.path[i].z);
+            highest = std::max(highest, prediction.path[i].z);
+        }
+
+        // Probe from the wall the player runs into, or from wherever the path ends, with a band that covers the whole path
+        PlayerState probe = player;
+        probe.position = prediction.path[contactStep >= 0 ? contactStep : prediction.pathSteps];
+        const Vec3 checkDir = DirFlatFromYaw(player.yaw);
+        const float minLedgeHeight = lowest - probe.position.z + thresholds.climbMinHeight;
+        const float maxLedgeHeight = std::max(highest - probe.position.z + thresholds.grabMaxHeight, thresholds.climbMaxHeight);
+        Vec3 ledgePoint;
+        if (!FindLedge(world, probe, thresholds, ledgePoint, checkDir, minLedgeHeight, maxLedgeHeight)) {
+            return prediction;
+        }
+
+        // First run of samples with the ledge in grab range and in front, within the forward probes' reach
+        const float reach = thresholds.ledgeForwardStep * static_cast<float>(thresholds.ledgeForwardIterations - 1);
+        int first = -1;
+        int last = -1;
+        for (int i = 0; i <= prediction.pathSteps; i++) {
+            const Vec3 &feet = prediction.path[i];
+            const float above = ledgePoint.z - feet.z;
+            const float ahead = (ledgePoint - feet).Dot(checkDir);
+            if (above >= thresholds.climbMinHeight && above <= thresholds.grabMaxHeight && ahead >= 0.0f && ahead <= reach) {
+                first = first < 0 ? i : first;
+                last = i;
+            }
+            else if (first >= 0) {
+                break;
+            }
+        }
+        if (first < 0) {
+            return prediction;
+        }
+
+        PlayerState atWindow = player;
+        atWindow.position = prediction.path[first];
+        const int ledgeType = ClassifyLedge(atWindow, thresholds, ledgePoint);
+        if (ledgeType != ParkourType::Grab) {
+            return prediction;
+        }
+        prediction.result = MakeDetectionResult(atWindow, thresholds, checkDir, ledgeType, ledgePoint);
+
+        // Half a step either side, the samples only say the ledge is in range somewhere around them
+        prediction.timeToContact = std::max((static_cast<float>(first) - 0.5f) * dt, 0.0f);
+        prediction.windowEnd = (static_cast<float>(last) + 0.5f) * dt;
+        return prediction;
+    }
+
+    const PredictedGrab &GrabPredictor::Update(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds,
+                                               std::uint64_t nowMs) {
+        if (!player.isMidairAndNotSliding) {
+            Reset();
+            return prediction;
+        }
+
+        if (valid) {
+            const float elapsed = Elapsed(nowMs);
+            if (elapsed <= thresholds.grabHorizon &&
+                (player.position - prediction.PathPosition(elapsed)).Length() <= thresholds.grabPathTolerance) {
+                stats.reuses++;
+                return prediction;
+            }
+        }
+
+        prediction = PredictGrab(world, player, thresholds);
+        predictedAtMs = nowMs;
+        valid = true;
+        stats.predictions++;
+        stats.grabsPredicted += prediction.HasGrab();
+        return prediction;
+    }
+
+    const DetectionResult *GrabPredictor::Due(std::uint64_t nowMs) const {
+        if (!valid || !prediction.HasGrab()) {
+            return nullptr;
+        }
+        const float elapsed = Elapsed(nowMs);
+        return elapsed >= prediction.timeToContact && elapsed <= prediction.windowEnd ? &prediction.result : nullptr;
+    }
+
+    std::int64_t GrabPredictor::MsUntilWindow(std::uint64_t nowMs) const {
+        if (!valid || !prediction.HasGrab()) {
+            return -1;
+        }
+        const float elapsed = Elapsed(nowMs);
+        if (elapsed > prediction.windowEnd) {
+            return -1;
+        }
+        if (elapsed >= prediction.timeToContact) {
+            return 0;
+        }
+        return static_cast<std::int64_t>(std::ceil((prediction.timeToContact - elapsed) * 1000.0f));
+    }
+
+    void GrabPredictor::Reset() {
+        prediction = {};
+        valid = false;
+    }
+
+    float GrabPredictor::Elapsed(std::uint64_t nowMs) const {
+        return nowMs > predictedAtMs ? static_cast<float>(nowMs - predictedAtMs) / 1000.0f : 0.0f;
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,143 @@
+#include "ParkourCore/HeadingScan.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+#include "ParkourCore/CountingWorldQuery.h"
+
+namespace ParkourCore {
+
+    namespace {
+        constexpr int maxHeadings = static_cast<int>(RayBatch::kCapacity) / 2;  // Two reach rays each, one batch
+
+        bool HasInput(const Vec3 &inputDir) {
+            return MagnitudeXY(inputDir.x, inputDir.y) > 0.001f;
+        }
+
+        struct Heading {
+                float offset = 0.0f;  // From the input yaw
+                float angle = 0.0f;   // Absolute, 0 to pi
+                bool inReach = false;
+        };
+
+        // As far as the vault or the ledge check looks
+        float ScanReach(const ScaledThresholds &thresholds) {
+            const float ledgeReach = thresholds.ledgeForwardStep * static_cast<float>(thresholds.ledgeForwardIterations - 1);
+            return std::max(thresholds.vaultLength, ledgeReach);
+        }
+    }  // namespace
+
+    HeadingScanResult ScanHeadings(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, bool smartParkour,
+                                   const Vec3 &inputDir) {
+        HeadingScanResult scan;
+        CountingWorldQuery counter(world);
+        const auto casts = [&counter] { return static_cast<std::uint32_t>(counter.rays + counter.sweeps); };
+
+        const float inputYaw = HasInput(inputDir) ? std::atan2(inputDir.x, inputDir.y) : player.yaw;
+        const int count = std::clamp(thresholds.headingCount, 1, maxHeadings);
+        const float step = 2.0f * std::numbers::pi_v<float> / static_cast<float>(count);
+
+        // 0, +1, -1, +2, -2 ... steps from the input, an even count ends on the single opposite heading
+        std::array<Heading, maxHeadings> headings;
+        for (int i = 0; i < count; i++) {
+            const int k = (i + 1) / 2;
+            headings[i].offset = static_cast<float>(i % 2 ? k : -k) * step;
+            headings[i].angle = static_cast<float>(k) * step;
+        }
+
+        // Just under the climb band and just under the vault band, as far as either check looks
+        const float reach = ScanReach(thresholds);
+        RayBatch reachBatch;
+        for (int i = 0; i < count; i++) {
+            const Vec3 dir = DirFlatFromYaw(inputYaw + headings[i].offset);
+            reachBatch.Add(player.position + Vec3(0, 0, thresholds.climbMinHeight - 1), dir, reach);
+            reachBatch.Add(player.position + Vec3(0, 0, thresholds.vaultMinHeight - 1), dir, reach);
+        }
+        counter.CastBatch(reachBatch);
+        for (int i = 0; i < count; i++) {
+            const float low = reachBatch.results[i * 2].distance;
+            const float high = reachBatch.results[i * 2 + 1].distance;
+            headings[i].inReach = low < reach || high < reach;
+        }
+        std::stable_partition(headings.begin(), headings.begin() + count, [](const Heading &h) { return h.inReach; });
+        scan.yaw = inputYaw;
+
+        const int budget = thresholds.headingRayBudget;
+        const int decisionCost = MaxCastsPerDecision(thresholds);
+        float bestScore = std::numeric_limits<float>::max();
+
+        for (int i = 0; i < count; i++) {
+            const auto &heading = headings[i];
+            if (heading.angle >= bestScore) {
+                scan.pruned++;
+                continue;
+            }
+            if (static_cast<int>(casts()) + decisionCost > budget) {
+                scan.budgetLimited = true;
+                break;
+            }
+
+            PlayerState turned = player;
+            turned.yaw = inputYaw + heading.offset;
+            const auto result = GetLedgePoint(counter, turned, thresholds, smartParkour);
+            scan.evaluated++;
+            if (result.ledgeType == ParkourType::NoLedge) {
+                continue;
+            }
+
+            const float distance = MagnitudeXY(result.ledgePoint.x - player.position.x, result.ledgePoint.y - player.position.y);
+            const float score = heading.angle + thresholds.headingDistanceWeight * distance;
+            if (score < bestScore) {
+                bestScore = score;
+                scan.best = result;
+                scan.yaw = turned.yaw;
+                scan.angle = heading.angle;
+            }
+        }
+
+        scan.casts = casts();
+        return scan;
+    }
+
+    float HeadingTracker::Update(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, bool smartParkour,
+                                 const Vec3 &inputDir, std::optional<HeadingScanResult> &scan) {
+        stats.updates++;
+        scan.reset();
+
+        const bool hasInput = HasInput(inputDir);
+        const float inputYaw = hasInput ? std::atan2(inputDir.x, inputDir.y) : player.yaw;
+        const int count = std::clamp(thresholds.headingCount, 1, maxHeadings);
+        const float step = 2.0f * std::numbers::pi_v<float> / static_cast<float>(count);
+        const int inputSector = static_cast<int>(std::lround(inputYaw / step)) % count;
+        const int wrappedSector = inputSector < 0 ? inputSector + count : inputSector;
+
+        // The offset only holds near where it was picked: past one forward step a ledge beside the path may have come
+        // into reach, and the one the scan found may have gone out of it
+        const Vec3 toScan = player.position - scanPosition;
+        const Vec3 toLedge = ledgePoint - player.position;
+        const bool moved = MagnitudeXY(toScan.x, toScan.y) > thresholds.ledgeForwardStep;
+        const bool lostLedge = hasLedge && MagnitudeXY(toLedge.x, toLedge.y) > ScanReach(thresholds);
+        if (valid && wrappedSector == sector && hasInput == moving && !moved && !lostLedge) {
+            return inputYaw + offset;
+        }
+
+        scan = ScanHeadings(world, player, thresholds, smartParkour, inputDir);
+        stats.scans++;
+        stats.scanCasts += scan->casts;
+        sector = wrappedSector;
+        moving = hasInput;
+        offset = scan->yaw - inputYaw;
+        scanPosition = player.position;
+        hasLedge = scan->best.ledgeType != ParkourType::NoLedge;
+        ledgePoint = scan->best.ledgePoint;
+        valid = true;
+        return scan->yaw;
+    }
+
+    void HeadingTracker::Reset() {
+        valid = false;
+    }
+}  // namespace ParkourCore
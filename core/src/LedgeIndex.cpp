@@ -0,0 +1,102 @@
+#include "ParkourCore/LedgeIndex.h"
+
+#include <utility>
+
+namespace ParkourCore {
+
+    bool LedgeIndexView::Open(std::span<const std::byte> bytes, std::string &errorOut) {
+        header = nullptr;
+        cellTable = nullptr;
+        ledges = nullptr;
+
+        if (bytes.size() < sizeof(LedgeIndexHeader)) {
+            errorOut = "ledge index: shorter than its header";
+            return false;
+        }
+        if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(LedgeIndexHeader) != 0) {
+            errorOut = "ledge index: bytes not aligned";
+            return false;
+        }
+
+        const auto *h = reinterpret_cast<const LedgeIndexHeader *>(bytes.data());
+        if (h->magic != ledgeIndexMagic) {
+            errorOut = "ledge index: not a ledge index";
+            return false;
+        }
+        if (h->version != ledgeIndexVersion || h->headerSize != sizeof(LedgeIndexHeader)) {
+            errorOut = "ledge index: version " + std::to_string(h->version) + ", expected " + std::to_string(ledgeIndexVersion);
+            return false;
+        }
+        if (h->fileSize != bytes.size()) {
+            errorOut = "ledge index: truncated";
+            return false;
+        }
+        if (!(h->gridSize > 0.0f) || !std::isfinite(h->originX) || !std::isfinite(h->originY)) {
+            errorOut = "ledge index: bad grid";
+            return false;
+        }
+
+        // 64 bit sums, a corrupt count can't wrap around into a valid looking size
+        const std::uint64_t cellCount = static_cast<std::uint64_t>(h->cellsX) * h->cellsY;
+        const std::uint64_t tableEnd = h->cellTableOffset + (cellCount + 1) * sizeof(std::uint32_t);
+        const std::uint64_t ledgesEnd = h->ledgeOffset + static_cast<std::uint64_t>(h->ledgeCount) * sizeof(BakedLedge);
+        if (h->cellTableOffset < sizeof(LedgeIndexHeader) || h->cellTableOffset % alignof(std::uint32_t) != 0 ||
+            tableEnd > h->ledgeOffset || h->ledgeOffset % alignof(BakedLedge) != 0 || ledgesEnd > bytes.size()) {
+            errorOut = "ledge index: sections out of bounds";
+            return false;
+        }
+
+        const auto *table = reinterpret_cast<const std::uint32_t *>(bytes.data() + h->cellTableOffset);
+        for (std::uint64_t i = 0; i < cellCount; i++) {
+            if (table[i] > table[i + 1]) {
+                errorOut = "ledge index: cell table out of order";
+                return false;
+            }
+        }
+        if (table[0] != 0 || table[cellCount] != h->ledgeCount) {
+            errorOut = "ledge index: cell table doesn't cover the ledges";
+            return false;
+        }
+
+        header = h;
+        cellTable = table;
+        ledges = reinterpret_cast<const BakedLedge *>(bytes.data() + h->ledgeOffset);
+        return true;
+    }
+
+    std::span<const BakedLedge> LedgeIndexView::Cell(std::int64_t x, std::int64_t y) const {
+        if (!header || x < 0 || y < 0 || x >= static_cast<std::int64_t>(header->cellsX) || y >= static_cast<std::int64_t>(header->cellsY)) {
+            return {};
+        }
+        const auto cell = static_cast<std::size_t>(y) * header->cellsX + static_cast<std::size_t>(x);
+        return {ledges + cellTable[cell], ledges + cellTable[cell + 1]};
+    }
+
+    bool LedgeIndex::LoadFile(const std::filesystem::path &path, std::string &errorOut) {
+        Clear();
+        if (!file.Open(path, errorOut)) {
+            return false;
+        }
+        if (!view.Open(file.Bytes(), errorOut)) {
+            Clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool LedgeIndex::Adopt(std::vector<std::byte> bytes, std::string &errorOut) {
+        Clear();
+        owned = std::move(bytes);
+        if (!view.Open(owned, errorOut)) {
+            Clear();
+            return false;
+        }
+        return true;
+    }
+
+    void LedgeIndex::Clear() {
+        view = {};
+        file.Close();
+        owned.clear();
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,217 @@
+#include "ParkourCore/LedgeIndexBaker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <tuple>
+
+namespace ParkourCore {
+
+    namespace {
+        // Vertices closer than a tenth of a unit are the same vertex, boxes and exported meshes repeat them exactly
+        using VertexKey = std::array<std::int64_t, 3>;
+
+        VertexKey KeyOf(const Vec3 &v) {
+            return {std::llround(v.x * 10.0f), std::llround(v.y * 10.0f), std::llround(v.z * 10.0f)};
+        }
+
+        struct Edge {
+                VertexKey lo;
+                VertexKey hi;
+                std::uint32_t triangle = 0;
+                int corner = 0;  // Edge from corner to corner + 1
+
+                bool operator<(const Edge &rhs) const {
+                    return std::tie(lo, hi, triangle, corner) < std::tie(rhs.lo, rhs.hi, rhs.triangle, rhs.corner);
+                }
+                bool SameAs(const Edge &rhs) const {
+                    return lo == rhs.lo && hi == rhs.hi;
+                }
+        };
+
+        Vec3 Corner(const Triangle &tri, int i) {
+            return i == 0 ? tri.a : i == 1 ? tri.b : tri.c;
+        }
+
+        Vec3 FaceNormal(const Triangle &tri) {
+            const Vec3 e1 = tri.b - tri.a;
+            const Vec3 e2 = tri.c - tri.a;
+            const Vec3 n(e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x);
+            const float length = n.Length();
+            return length > 0.0f ? n * (1.0f / length) : Vec3();
+        }
+
+        template <class T>
+        void Put(std::vector<std::byte> &bytes, std::size_t offset, const T &value) {
+            std::memcpy(bytes.data() + offset, &value, sizeof(T));
+        }
+    }  // namespace
+
+    std::vector<std::byte> BakeLedgeIndex(CollisionScene &scene, const LedgeBakeSettings &settings, LedgeBakeStats *stats) {
+        LedgeBakeStats local;
+        auto &s = stats ? *stats : local;
+        s = {};
+
+        // Walkable triangles on baked layers and their edges
+        const auto &triangles = scene.Triangles();
+        std::vector<Edge> edges;
+        for (std::uint32_t t = 0; t < triangles.size(); t++) {
+            const auto &tri = triangles[t];
+            if (!IsBakedLayer(tri.layer)) {
+                continue;
+            }
+            s.triangles++;
+            if (FaceNormal(tri).z < settings.minWalkableZ) {
+                continue;
+            }
+            s.walkable++;
+            for (int i = 0; i < 3; i++) {
+                auto a = KeyOf(Corner(tri, i));
+                auto b = KeyOf(Corner(tri, (i + 1) % 3));
+                if (b < a) {
+                    std::swap(a, b);
+                }
+                edges.push_back({a, b, t, i});
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        std::vector<BakedLedge> ledges;
+        for (std::size_t i = 0; i < edges.size();) {
+            std::size_t run = i + 1;
+            while (run < edges.size() && edges[run].SameAs(edges[i])) {
+                run++;
+            }
+            const bool open = run - i == 1;
+            const Edge edge = edges[i];
+            i = run;
+            if (!open) {
+                continue;  // Between two walkable triangles, inside a top
+            }
+            s.openEdges++;
+
+            const auto &tri = triangles[edge.triangle];
+            const Vec3 u = Corner(tri, edge.corner);
+            const Vec3 v = Corner(tri, (edge.corner + 1) % 3);
+            const Vec3 w = Corner(tri, (edge.corner + 2) % 3);
+
+            // Flat normal away from the triangle's third corner, off the top
+            const float length = MagnitudeXY(v.x - u.x, v.y - u.y);
+            if (length <= 0.0f) {
+                continue;  // Vertical edge seen from above
+            }
+            Vec3 normal((v.y - u.y) / length, -(v.x - u.x) / length, 0.0f);
+            if ((w - u).Dot(normal) > 0.0f) {
+                normal = -normal;
+            }
+
+            const int samples = std::max(1, static_cast<int>(std::ceil(length / settings.sampleSpacing)));
+            for (int k = 0; k < samples; k++) {
+                s.samples++;
+                const float f = (static_cast<float>(k) + 0.5f) / static_cast<float>(samples);
+                const Vec3 point = u + (v - u) * f;
+
+                // Nothing rising right past the edge, a step's riser or a wall the top runs into
+                if (scene.CastRay(point + Vec3(0, 0, 2), normal, settings.probeOffset).HasHit()) {
+                    s.rejectedWall++;
+                    continue;
+                }
+
+                // From just above the top so a neighbouring top level with this one ends it as a seam. Any layer is a
+                // floor here, water included, the fraction still gives the height where the distance is -1.
+                const Vec3 dropStart = point + normal * settings.probeOffset + Vec3(0, 0, 1);
+                const RayHit floor = scene.CastRay(dropStart, Vec3(0, 0, -1), settings.maxDropProbe);
+                const float height = floor.hitFraction * settings.maxDropProbe - 1.0f;
+                if (!floor.HasHit() || height < settings.minHeight) {
+                    s.rejectedDrop++;
+                    continue;
+                }
+
+                const Vec3 topPoint = point - normal * 4.0f + Vec3(0, 0, 1);
+                const float clearance = std::max(scene.CastRay(topPoint, Vec3(0, 0, 1), settings.clearanceProbe).distance, 0.0f);
+                if (clearance < settings.minClearance) {
+                    s.rejectedBuried++;
+                    continue;
+                }
+
+                ledges.push_back({point, normal.x, normal.y, height, clearance, tri.layer});
+            }
+        }
+        s.ledges = ledges.size();
+
+        // Grid over the ledges, then a counting sort into it
+        float minX = 0.0f;
+        float minY = 0.0f;
+        float maxX = 0.0f;
+        float maxY = 0.0f;
+        if (!ledges.empty()) {
+            minX = maxX = ledges[0].position.x;
+            minY = maxY = ledges[0].position.y;
+            for (const auto &ledge: ledges) {
+                minX = std::min(minX, ledge.position.x);
+                minY = std::min(minY, ledge.position.y);
+                maxX = std::max(maxX, ledge.position.x);
+                maxY = std::max(maxY, ledge.position.y);
+            }
+        }
+
+        LedgeIndexHeader header;
+        header.headerSize = sizeof(LedgeIndexHeader);
+        header.cellKey = settings.cellKey;
+        header.gridSize = settings.gridSize;
+        header.sampleSpacing = settings.sampleSpacing;
+        header.originX = std::floor(minX / settings.gridSize) * settings.gridSize;
+        header.originY = std::floor(minY / settings.gridSize) * settings.gridSize;
+        header.cellsX = static_cast<std::uint32_t>((maxX - header.originX) / settings.gridSize) + 1;
+        header.cellsY = static_cast<std::uint32_t>((maxY - header.originY) / settings.gridSize) + 1;
+        header.ledgeCount = static_cast<std::uint32_t>(ledges.size());
+
+        const std::size_t cellCount = static_cast<std::size_t>(header.cellsX) * header.cellsY;
+        const auto cellOf = [&](const BakedLedge &ledge) {
+            const auto x = std::min(static_cast<std::uint32_t>((ledge.position.x - header.originX) / settings.gridSize), header.cellsX - 1);
+            const auto y = std::min(static_cast<std::uint32_t>((ledge.position.y - header.originY) / settings.gridSize), header.cellsY - 1);
+            return static_cast<std::size_t>(y) * header.cellsX + x;
+        };
+
+        std::vector<std::uint32_t> table(cellCount + 1, 0);
+        for (const auto &ledge: ledges) {
+            table[cellOf(ledge) + 1]++;
+        }
+        for (std::size_t c = 0; c < cellCount; c++) {
+            table[c + 1] += table[c];
+        }
+        std::vector<BakedLedge> sorted(ledges.size());
+        std::vector<std::uint32_t> next(table.begin(), table.end() - 1);
+        for (const auto &ledge: ledges) {
+            sorted[next[cellOf(ledge)]++] = ledge;
+        }
+
+        const std::uint64_t tableBytes = table.size() * sizeof(std::uint32_t);
+        const std::uint64_t fileSize = sizeof(LedgeIndexHeader) + tableBytes + sorted.size() * sizeof(BakedLedge);
+        if (fileSize > std::numeric_limits<std::uint32_t>::max()) {
+            return {};
+        }
+        header.cellTableOffset = sizeof(LedgeIndexHeader);
+        header.ledgeOffset = static_cast<std::uint32_t>(header.cellTableOffset + tableBytes);
+        header.fileSize = static_cast<std::uint32_t>(fileSize);
+
+        std::vector<std::byte> bytes(static_cast<std::size_t>(fileSize));
+        Put(bytes, 0, header);
+        std::memcpy(bytes.data() + header.cellTableOffset, table.data(), tableBytes);
+        if (!sorted.empty()) {
+            std::memcpy(bytes.data() + header.ledgeOffset, sorted.data(), sorted.size() * sizeof(BakedLedge));
+        }
+        return bytes;
+    }
+
+    bool WriteLedgeIndex(const std::filesystem::path &path, std::span<const std::byte> bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+}  // namespace ParkourCore
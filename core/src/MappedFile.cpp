@@ -0,0 +1,126 @@
+#include "ParkourCore/MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace ParkourCore {
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            Close();
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+#ifdef _WIN32
+            mapping = std::exchange(other.mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Open(const std::filesystem::path &path, std::string &errorOut) {
+        Close();
+        const HANDLE file =
+            CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            errorOut = "can't open " + path.string();
+            return false;
+        }
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            errorOut = path.string() + " is empty";
+            return false;
+        }
+
+        // The mapping keeps the file open on its own
+        const HANDLE fileMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!fileMapping) {
+            errorOut = "can't map " + path.string();
+            return false;
+        }
+
+        const void *view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(fileMapping);
+            errorOut = "can't map " + path.string();
+            return false;
+        }
+
+        mapping = fileMapping;
+        data = static_cast<const std::byte *>(view);
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (data) {
+            UnmapViewOfFile(data);
+            CloseHandle(mapping);
+        }
+        data = nullptr;
+        size = 0;
+        mapping = nullptr;
+    }
+#else
+    bool MappedFile::Open(const std::filesystem::path &path, std::string &errorOut) {
+        Close();
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            errorOut = "can't open " + path.string();
+            return false;
+        }
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            errorOut = path.string() + " is empty";
+            return false;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        void *view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            errorOut = "can't map " + path.string();
+            return false;
+        }
+
+        data = static_cast<const std::byte *>(view);
+        size = static_cast<std::size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (data) {
+            ::munmap(const_cast<std::byte *>(data), size);
+        }
+        data = nullptr;
+        size = 0;
+    }
+#endif
+}  // namespace ParkourCore
@@ -0,0 +1,218 @@
+#include "ParkourCore/NegativeCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace ParkourCore {
+
+    namespace {
+        std::int32_t Quantise(float value, float step) {
+            return static_cast<std::int32_t>(std::floor(value / step));
+        }
+
+        float LedgeReach(const ScaledThresholds &thresholds) {
+            return thresholds.ledgeForwardStep * static_cast<float>(thresholds.ledgeForwardIterations - 1);
+        }
+
+        float VaultReach(const ScaledThresholds &thresholds) {
+            return thresholds.vaultDownStep * static_cast<float>(thresholds.vaultDownIterations - 1);
+        }
+
+        float FaceReach(const ScaledThresholds &thresholds) {
+            return std::max(thresholds.vaultLength, LedgeReach(thresholds));
+        }
+
+        float MaxUpCheck(const ScaledThresholds &thresholds) {
+            return (thresholds.climbMaxHeight - thresholds.ledgeStartZOffset) + thresholds.ledgeUpCheckMargin;
+        }
+
+        // LedgeCheck's up ray and the forward ray it casts from just under the up ray's end, plus one straight ahead
+        // just under the climb band, as far as either check looks. A ceiling or a wall coming into reach moves one of them.
+        // Distances of any layer, an actor in the way is a change too.
+        NegativeConfirm CastConfirm(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds) {
+            const Vec3 checkDir = DirFlatFromYaw(player.yaw);
+            const Vec3 upRayStart = player.position + Vec3(0, 0, thresholds.ledgeStartZOffset);
+
+            RayBatch first;
+            first.Add(upRayStart, Vec3(0, 0, 1), MaxUpCheck(thresholds));
+            first.Add(player.position + Vec3(0, 0, thresholds.climbMinHeight - 1), checkDir, FaceReach(thresholds));
+            world.CastBatch(first);
+
+            NegativeConfirm confirm;
+            confirm.up = first.results[0].distance;
+            confirm.face = first.results[1].distance;
+            const Vec3 fwdRayStart = upRayStart + Vec3(0, 0, confirm.up - 10);
+            confirm.forward = world.CastRay(fwdRayStart, checkDir, LedgeReach(thresholds)).distance;
+            return confirm;
+        }
+
+        bool SameConfirm(const NegativeConfirm &a, const NegativeConfirm &b, float tolerance) {
+            return std::abs(a.up - b.up) <= tolerance && std::abs(a.forward - b.forward) <= tolerance &&
+                   std::abs(a.face - b.face) <= tolerance;
+        }
+
+        // Down rays past the far end of both checks, as far as a move across the cell shifts them. Anything on top in
+        // the climb or vault band there can come into reach without the confirm rays seeing it, a rail or a slab
+        // hanging over the player has no face below.
+        bool ClearPastReach(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, float lookahead,
+                            std::uint64_t &rays) {
+            const Vec3 checkDir = DirFlatFromYaw(player.yaw);
+            const float ledgeTop = thresholds.ledgeStartZOffset + MaxUpCheck(thresholds) - 10;
+            const float ledgeDown = thresholds.ledgeStartZOffset + MaxUpCheck(thresholds);
+            const float vaultDown = thresholds.vaultHeadHeight + 100.0f;
+
+            RayBatch batch;
+            const auto addAfter = [&](float reach, float step, float top, float length) {
+                for (float d = reach + step; d < reach + lookahead + step && batch.Size() < RayBatch::kCapacity; d += step) {
+                    Vec3 origin = player.position + checkDir * d;
+                    origin.z += top;
+                    batch.Add(origin, Vec3(0, 0, -1), length);
+                }
+            };
+            addAfter(LedgeReach(thresholds), thresholds.ledgeForwardStep, ledgeTop, ledgeDown);
+            const std::size_t firstVault = batch.Size();
+            addAfter(VaultReach(thresholds), thresholds.vaultDownStep, thresholds.vaultHeadHeight, vaultDown);
+            world.CastBatch(batch);
+            rays += batch.Size();
+
+            for (std::size_t i = 0; i < batch.Size(); i++) {
+                const float height = batch.Origin(i).z - batch.results[i].distance - player.position.z;
+                const bool inBand = i < firstVault ? height >= thresholds.climbMinHeight && height <= thresholds.climbMaxHeight
+                                                   : height > thresholds.vaultMinHeight && height < thresholds.vaultMaxHeight;
+                if (inBand) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }  // namespace
+
+    NegativeKey NegativeCache::MakeKey(const PlayerState &player, bool smartParkour) const {
+        constexpr float twoPi = 2.0f * std::numbers::pi_v<float>;
+        float yaw = std::fmod(player.yaw, twoPi);
+        yaw = yaw < 0.0f ? yaw + twoPi : yaw;
+
+        NegativeKey key;
+        key.x = Quantise(player.position.x, config.positionStep);
+        key.y = Quantise(player.position.y, config.positionStep);
+        key.z = Quantise(player.position.z, config.positionStep);
+        // Lowest float means no water, clamp so it doesn't overflow the integer
+        key.waterHeight = Quantise(std::max(player.waterHeight, -1e6f), config.positionStep);
+        key.yaw = static_cast<std::uint16_t>(static_cast<int>(yaw / twoPi * static_cast<float>(config.yawBuckets)) % config.yawBuckets);
+        key.flags = static_cast<std::uint8_t>(player.isMoving << 0 | player.isGroundedOrSliding << 1 | player.isMidairAndNotSliding << 2 |
+                                              player.isSwimming << 3 | player.isOnStairs << 4 | player.shouldReplaceWithFailed << 5 |
+                                              smartParkour << 6);
+        return key;
+    }
+
+    void NegativeCache::SetContext(std::uint32_t cellId, float scale) {
+        if (cellId != cell || scale != contextScale) {
+            cell = cellId;
+            contextScale = scale;
+            Invalidate();
+        }
+    }
+
+    void NegativeCache::Invalidate() {
+        for (auto &set: sets) {
+            for (auto &entry: set) {
+                entry.valid = false;
+            }
+        }
+        stats.invalidations++;
+    }
+
+    NegativeCache::Set &NegativeCache::SetFor(const NegativeKey &key) {
+        // Neighbouring cells land in different sets, a walk through open ground spreads over the whole table
+        std::uint32_t hash = static_cast<std::uint32_t>(key.x) * 73856093u ^ static_cast<std::uint32_t>(key.y) * 19349663u ^
+                             static_cast<std::uint32_t>(key.z) * 83492791u ^ static_cast<std::uint32_t>(key.yaw) * 2654435761u;
+        hash ^= hash >> 16;
+        return sets[hash % setCount];
+    }
+
+    NegativeCache::Entry *NegativeCache::Lookup(const NegativeKey &key) {
+        for (auto &entry: SetFor(key)) {
+            if (entry.valid && entry.key == key) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    bool NegativeCache::Check(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, const NegativeKey &key,
+                              std::uint64_t nowMs) {
+        stats.lookups++;
+        const auto entry = Lookup(key);
+        if (!entry) {
+            return false;
+        }
+        if (nowMs - entry->storedMs > config.ttlMs) {
+            entry->valid = false;
+            stats.expired++;
+            return false;
+        }
+
+        constexpr std::uint64_t confirmRays = 3;
+        stats.raysCast += confirmRays;
+        if (!SameConfirm(CastConfirm(world, player, thresholds), entry->confirm, config.confirmTolerance)) {
+            entry->valid = false;
+            stats.confirmFailures++;
+            return false;
+        }
+
+        stats.hits++;
+        stats.raysSaved += entry->rays > confirmRays ? entry->rays - confirmRays : 0;
+        return true;
+    }
+
+    void NegativeCache::Store(WorldQuery &world, const PlayerState &player, const ScaledThresholds &thresholds, const NegativeKey &key,
+                              std::uint64_t rays, std::uint64_t nowMs) {
+        // A diagonal across the cell, the furthest a pose with this key can be from this one
+        const float lookahead = config.positionStep * std::numbers::sqrt2_v<float>;
+        if (!ClearPastReach(world, player, thresholds, lookahead, stats.raysCast)) {
+            stats.refused++;
+            Erase(key);
+            return;
+        }
+        const NegativeConfirm confirmRays = CastConfirm(world, player, thresholds);
+        stats.raysCast += 3;
+
+        // The same key if present, else a free or expired way, else the oldest
+        auto &set = SetFor(key);
+        Entry *target = Lookup(key);
+        if (!target) {
+            target = &set[0];
+            for (auto &entry: set) {
+                if (!entry.valid || nowMs - entry.storedMs > config.ttlMs) {
+                    target = &entry;
+                    break;
+                }
+                if (entry.storedMs < target->storedMs) {
+                    target = &entry;
+                }
+            }
+            if (target->valid && nowMs - target->storedMs <= config.ttlMs) {
+                stats.evictions++;
+            }
+        }
+
+        target->key = key;
+        target->confirm = confirmRays;
+        target->rays = static_cast<std::uint32_t>(rays);
+        target->storedMs = nowMs;
+        target->valid = true;
+        stats.stores++;
+    }
+
+    void NegativeCache::Erase(const NegativeKey &key) {
+        if (const auto entry = Lookup(key)) {
+            entry->valid = false;
+        }
+    }
+
+    void NegativeCache::SetConfig(const NegativeCacheConfig &a_config) {
+        config = a_config;
+        Invalidate();
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,55 @@
+#include "ParkourCore/QualityTier.h"
+
+#include <algorithm>
+
+namespace ParkourCore {
+
+    bool QualityGovernor::AddFrame(float frameMs, float downMs, float upMs) {
+        stats.frames++;
+        stats.framesAt[tier - DetectionQuality::Low]++;
+        held++;
+
+        // Running sum over the ring, the oldest sample drops out once it is full
+        if (count == window) {
+            sum -= samples[next];
+        }
+        else {
+            count++;
+        }
+        samples[next] = frameMs;
+        sum += frameMs;
+        next = (next + 1) % window;
+
+        if (count < window || held < holdFrames) {
+            return false;
+        }
+
+        const float average = sum / static_cast<float>(count);
+        int wanted = tier;
+        if (average > downMs) {
+            wanted = std::max(tier - 1, lowestTier);
+        }
+        else if (average < upMs) {
+            wanted = std::min(tier + 1, DetectionQuality::High);
+        }
+        if (wanted == tier) {
+            return false;
+        }
+
+        (wanted < tier ? stats.stepsDown : stats.stepsUp)++;
+        tier = wanted;
+        count = 0;
+        next = 0;
+        sum = 0.0f;
+        held = 0;
+        return true;
+    }
+
+    void QualityGovernor::Reset(int a_tier) {
+        tier = std::clamp(a_tier, lowestTier, DetectionQuality::High);
+        count = 0;
+        next = 0;
+        sum = 0.0f;
+        held = holdFrames;
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,42 @@
+#include "ParkourCore/RayBatch.h"
+
+namespace ParkourCore {
+
+    RayHit WorldQuery::CastRay(const Vec3 &origin, const Vec3 &dir, float maxDist) {
+        RayBatch batch;
+        batch.Add(origin, dir, maxDist);
+        CastBatch(batch);
+        return batch.results[0];
+    }
+
+    RayHit WorldQuery::SweepBox(const Vec3 &origin, const Vec3 &halfExtents, const Vec3 &dir, float maxDist) {
+        RayBatch batch;
+        batch.Add(origin, dir, maxDist);
+
+        // Corners only, a zero extent collapses its pair so a flat box casts 4 corners instead of 8
+        const int nx = halfExtents.x > 0.0f ? 2 : 1;
+        const int ny = halfExtents.y > 0.0f ? 2 : 1;
+        const int nz = halfExtents.z > 0.0f ? 2 : 1;
+        if (nx * ny * nz > 1) {
+            for (int ix = 0; ix < nx; ix++) {
+                for (int iy = 0; iy < ny; iy++) {
+                    for (int iz = 0; iz < nz; iz++) {
+                        const Vec3 corner{ix ? halfExtents.x : -halfExtents.x, iy ? halfExtents.y : -halfExtents.y,
+                                          iz ? halfExtents.z : -halfExtents.z};
+                        batch.Add(origin + corner, dir, maxDist);
+                    }
+                }
+            }
+        }
+        CastBatch(batch);
+
+        // Nearest hit wins, a non parkour layer (-1) counts as nearest like it does for a single ray
+        RayHit nearest = batch.results[0];
+        for (std::size_t i = 1; i < batch.Size(); i++) {
+            if (batch.results[i].distance < nearest.distance) {
+                nearest = batch.results[i];
+            }
+        }
+        return nearest;
+    }
+}  // namespace ParkourCore
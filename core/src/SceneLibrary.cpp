@@ -0,0 +1,170 @@
+#include "ParkourCore/SceneLibrary.h"
+
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace ParkourCore::SceneLibrary {
+
+    namespace {
+        constexpr float halfWidth = 150.0f;  // Obstacles are wider than any sideways probe
+
+        CollisionScene Finish(CollisionScene &&scene) {
+            scene.Build();
+            return std::move(scene);
+        }
+    }  // namespace
+
+    void AddGround(CollisionScene &scene, float z) {
+        scene.AddBox({-groundHalfSize, -groundHalfSize, z - 10.0f}, {groundHalfSize, groundHalfSize, z}, CollisionLayer::kGround);
+    }
+
+    CollisionScene Flat() {
+        CollisionScene scene;
+        AddGround(scene);
+        return Finish(std::move(scene));
+    }
+
+    CollisionScene Wall(float height, float depth) {
+        CollisionScene scene;
+        AddGround(scene);
+        scene.AddBox({-halfWidth, obstacleDistance, 0.0f}, {halfWidth, obstacleDistance + depth, height}, CollisionLayer::kStatic);
+        return Finish(std::move(scene));
+    }
+
+    CollisionScene Stairs(int steps, float rise, float run) {
+        CollisionScene scene;
+        AddGround(scene);
+        for (int i = 0; i < steps; i++) {
+            const float y = obstacleDistance + run * static_cast<float>(i);
+            const float top = rise * static_cast<float>(i + 1);
+            scene.AddBox({-halfWidth, y, 0.0f}, {halfWidth, y + run, top}, CollisionLayer::kStatic);
+        }
+        return Finish(std::move(scene));
+    }
+
+    CollisionScene Fence(float height, float thickness) {
+        CollisionScene scene;
+        AddGround(scene);
+        scene.AddBox({-halfWidth, obstacleDistance, 0.0f}, {halfWidth, obstacleDistance + thickness, height}, CollisionLayer::kProps);
+        return Finish(std::move(scene));
+    }
+
+    // Bar on posts, the posts stand outside every probe so the bar floats as far as detection can tell
+    CollisionScene Rail(float height, float thickness) {
+        CollisionScene scene;
+        AddGround(scene);
+        const float y = obstacleDistance;
+        scene.AddBox({-halfWidth, y, height - thickness}, {halfWidth, y + thickness, height}, CollisionLayer::kProps);
+        for (const float x: {-halfWidth, halfWidth - thickness}) {
+            scene.AddBox({x, y, 0.0f}, {x + thickness, y + thickness, height - thickness}, CollisionLayer::kProps);
+        }
+        return Finish(std::move(scene));
+    }
+
+    CollisionScene LowWall(float height, float thickness) {
+        CollisionScene scene;
+        AddGround(scene);
+        scene.AddBox({-halfWidth, obstacleDistance, 0.0f}, {halfWidth, obstacleDistance + thickness, height}, CollisionLayer::kStatic);
+        return Finish(std::move(scene));
+    }
+
+    CollisionScene Slope(float angleDegrees) {
+        CollisionScene scene;
+        AddGround(scene);
+        const float rise = std::tan(angleDegrees * std::numbers::pi_v<float> / 180.0f) * 400.0f;
+        const Vec3 a{-halfWidth, obstacleDistance, 0.0f};
+        const Vec3 b{halfWidth, obstacleDistance, 0.0f};
+        const Vec3 c{halfWidth, obstacleDistance + 400.0f, rise};
+        const Vec3 d{-halfWidth, obstacleDistance + 400.0f, rise};
+        scene.AddTriangle({a, b, c, CollisionLayer::kTerrain});
+        scene.AddTriangle({a, c, d, CollisionLayer::kTerrain});
+        return Finish(std::move(scene));
+    }
+
+    CollisionScene WaterPlane(float waterHeight, float ledgeHeight) {
+        CollisionScene scene;
+        // Player is swimming in a pool, the pool edge is the ledge
+        AddGround(scene, -300.0f);
+        scene.AddBox({-halfWidth, obstacleDistance, -300.0f}, {halfWidth, obstacleDistance + 200.0f, ledgeHeight}, CollisionLayer::kStatic);
+        const Vec3 a{-groundHalfSize, -groundHalfSize, waterHeight};
+        const Vec3 b{groundHalfSize, -groundHalfSize, waterHeight};
+        const Vec3 c{groundHalfSize, obstacleDistance, waterHeight};
+        const Vec3 d{-groundHalfSize, obstacleDistance, waterHeight};
+        scene.AddTriangle({a, b, c, CollisionLayer::kWater});
+        scene.AddTriangle({a, c, d, CollisionLayer::kWater});
+        return Finish(std::move(scene));
+    }
+
+    CollisionScene Overhang(float ledgeHeight, float clearance) {
+        CollisionScene scene;
+        AddGround(scene);
+        scene.AddBox({-halfWidth, obstacleDistance, 0.0f}, {halfWidth, obstacleDistance + 200.0f, ledgeHeight}, CollisionLayer::kStatic);
+        // Slab above the ledge top, hanging out over the player
+        scene.AddBox({-halfWidth, -20.0f, ledgeHeight + clearance}, {halfWidth, obstacleDistance + 200.0f, ledgeHeight + clearance + 20.0f},
+                     CollisionLayer::kStatic);
+        return Finish(std::move(scene));
+    }
+
+    // Narrow beam running back over the ledge top, offset sideways so the probe line passes beside it
+    CollisionScene Beam(float ledgeHeight, float clearance, float offset) {
+        CollisionScene scene;
+        AddGround(scene);
+        scene.AddBox({-halfWidth, obstacleDistance, 0.0f}, {halfWidth, obstacleDistance + 200.0f, ledgeHeight}, CollisionLayer::kStatic);
+        const float beamZ = ledgeHeight + clearance;
+        scene.AddBox({offset, obstacleDistance, beamZ}, {offset + 4.0f, obstacleDistance + 200.0f, beamZ + 6.0f}, CollisionLayer::kStatic);
+        return Finish(std::move(scene));
+    }
+
+    std::vector<Case> StandardCorpus() {
+        std::vector<Case> corpus;
+
+        const auto add = [&corpus](std::string name, CollisionScene scene, PlayerState player = {}) {
+            PlayerState moving = player;
+            moving.isMoving = true;
+            corpus.push_back({name + "/standing", scene, player});
+            corpus.push_back({name + "/moving", std::move(scene), moving});
+        };
+
+        add("flat", Flat());
+
+        // One wall inside every ledge band, plus one just above each band limit
+        for (const float height: {25.0f, 45.0f, 60.0f, 85.0f, 100.0f, 128.0f, 140.0f, 175.0f, 190.0f, 225.0f, 240.0f, 280.0f}) {
+            add("wall_" + std::to_string(static_cast<int>(height)), Wall(height));
+        }
+
+        for (const float height: {35.0f, 50.0f, 65.0f, 80.0f, 95.0f}) {
+            add("fence_" + std::to_string(static_cast<int>(height)), Fence(height));
+            add("lowwall_" + std::to_string(static_cast<int>(height)), LowWall(height));
+        }
+
+        for (const float height: {50.0f, 65.0f, 85.0f}) {
+            add("rail_" + std::to_string(static_cast<int>(height)), Rail(height));
+        }
+
+        add("stairs_shallow", Stairs(8, 15.0f, 30.0f));
+        add("stairs_steep", Stairs(8, 30.0f, 25.0f));
+
+        for (const float angle: {15.0f, 30.0f, 45.0f}) {
+            add("slope_" + std::to_string(static_cast<int>(angle)), Slope(angle));
+        }
+
+        PlayerState swimming;
+        swimming.position = {0.0f, 0.0f, -60.0f};
+        swimming.isSwimming = true;
+        swimming.isGroundedOrSliding = false;
+        swimming.waterHeight = 0.0f;
+        add("water_ledge_20", WaterPlane(0.0f, 20.0f), swimming);
+        add("water_ledge_60", WaterPlane(0.0f, 60.0f), swimming);
+
+        for (const float clearance: {40.0f, 90.0f, 200.0f}) {
+            add("overhang_100_" + std::to_string(static_cast<int>(clearance)), Overhang(100.0f, clearance));
+        }
+
+        for (const float offset: {8.0f, 40.0f}) {
+            add("beam_100_60_" + std::to_string(static_cast<int>(offset)), Beam(100.0f, 60.0f, offset));
+        }
+
+        return corpus;
+    }
+}  // namespace ParkourCore::SceneLibrary
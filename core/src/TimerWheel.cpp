@@ -0,0 +1,162 @@
+#include "ParkourCore/TimerWheel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ParkourCore {
+
+    TimerWheel::TimerWheel(std::uint64_t startMs) {
+        msWheel.heads.fill(none);
+        frameWheel.heads.fill(none);
+        msWheel.now = startMs;
+    }
+
+    TimerWheel::Handle TimerWheel::AfterMs(std::uint64_t nowMs, std::uint32_t delayMs, Callback callback) {
+        std::scoped_lock guard(lock);
+        // The wheel clock only moves while pumped, so an idle wheel may be behind the caller
+        const auto base = std::max(nowMs, msWheel.now);
+        return Insert(Clock::kMs, base + std::max<std::uint32_t>(delayMs, 1), std::move(callback));
+    }
+
+    TimerWheel::Handle TimerWheel::AfterFrames(std::uint32_t frames, Callback callback) {
+        std::scoped_lock guard(lock);
+        return Insert(Clock::kFrames, frameWheel.now + std::max<std::uint32_t>(frames, 1), std::move(callback));
+    }
+
+    bool TimerWheel::Cancel(Handle handle) {
+        std::scoped_lock guard(lock);
+        if (!handle.IsValid() || handle.index >= timers.size()) {
+            return false;
+        }
+        auto &timer = timers[handle.index];
+        if (!timer.active || timer.generation != handle.generation) {
+            return false;
+        }
+        Unlink(WheelFor(timer.clock), handle.index);
+        Release(handle.index);
+        return true;
+    }
+
+    std::size_t TimerWheel::Advance(std::uint64_t nowMs) {
+        std::vector<Callback> firing;
+        {
+            std::scoped_lock guard(lock);
+            due.clear();
+            CollectDue(msWheel, std::max(nowMs, msWheel.now), due);
+            CollectDue(frameWheel, frameWheel.now + 1, due);
+            if (due.empty()) {
+                return 0;
+            }
+
+            // Millisecond timers first, each clock in deadline then scheduling order
+            std::sort(due.begin(), due.end(), [this](std::uint32_t a, std::uint32_t b) {
+                const auto &ta = timers[a];
+                const auto &tb = timers[b];
+                if (ta.clock != tb.clock) {
+                    return ta.clock < tb.clock;
+                }
+                return ta.deadline != tb.deadline ? ta.deadline < tb.deadline : ta.sequence < tb.sequence;
+            });
+
+            firing.reserve(due.size());
+            for (const auto index: due) {
+                firing.push_back(std::move(timers[index].callback));
+                Release(index);
+            }
+        }
+
+        // Unlocked, callbacks may schedule or cancel
+        for (auto &callback: firing) {
+            callback();
+        }
+        return firing.size();
+    }
+
+    std::size_t TimerWheel::Pending() const {
+        std::scoped_lock guard(lock);
+        return pending;
+    }
+
+    std::uint64_t TimerWheel::Frame() const {
+        std::scoped_lock guard(lock);
+        return frameWheel.now;
+    }
+
+    TimerWheel::Handle TimerWheel::Insert(Clock clock, std::uint64_t deadline, Callback &&callback) {
+        std::uint32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        }
+        else {
+            index = static_cast<std::uint32_t>(timers.size());
+            timers.emplace_back();
+        }
+
+        auto &timer = timers[index];
+        timer.callback = std::move(callback);
+        timer.deadline = deadline;
+        timer.sequence = nextSequence++;
+        timer.clock = clock;
+        timer.active = true;
+        Link(WheelFor(clock), index);
+        pending++;
+        return {index, timer.generation};
+    }
+
+    void TimerWheel::Link(Wheel &wheel, std::uint32_t index) {
+        auto &timer = timers[index];
+        auto &head = wheel.heads[timer.deadline % slotCount];
+        timer.prev = none;
+        timer.next = head;
+        if (head != none) {
+            timers[head].prev = index;
+        }
+        head = index;
+    }
+
+    void TimerWheel::Unlink(Wheel &wheel, std::uint32_t index) {
+        auto &timer = timers[index];
+        if (timer.prev != none) {
+            timers[timer.prev].next = timer.next;
+        }
+        else {
+            wheel.heads[timer.deadline % slotCount] = timer.next;
+        }
+        if (timer.next != none) {
+            timers[timer.next].prev = timer.prev;
+        }
+        timer.prev = none;
+        timer.next = none;
+    }
+
+    void TimerWheel::Release(std::uint32_t index) {
+        auto &timer = timers[index];
+        timer.callback.Reset();
+        timer.active = false;
+        timer.generation++;
+        freeList.push_back(index);
+        pending--;
+    }
+
+    // Visits every slot passed since the last advance, or the whole wheel once after a long hitch.
+    // Timers in a visited slot that belong to a later turn stay linked.
+    void TimerWheel::CollectDue(Wheel &wheel, std::uint64_t now, std::vector<std::uint32_t> &dueOut) {
+        if (now <= wheel.now) {
+            return;
+        }
+        const auto steps = std::min<std::uint64_t>(now - wheel.now, slotCount);
+        for (std::uint64_t step = 1; step <= steps; step++) {
+            auto index = wheel.heads[(wheel.now + step) % slotCount];
+            while (index != none) {
+                const auto next = timers[index].next;
+                if (timers[index].deadline <= now) {
+                    Unlink(wheel, index);
+                    dueOut.push_back(index);
+                }
+                index = next;
+            }
+        }
+        wheel.now = now;
+    }
+}  // namespace ParkourCore
@@ -0,0 +1,257 @@
+#include "ParkourCore/Tuning.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "ParkourCore/RayBatch.h"
+
+namespace ParkourCore::Tuning {
+
+    namespace {
+        struct FloatKey {
+                std::string_view section;
+                std::string_view key;
+                float ScaledThresholds::*field;
+        };
+
+        struct IntKey {
+                std::string_view section;
+                std::string_view key;
+                int ScaledThresholds::*field;
+                int min;
+                int max;
+        };
+
+        using T = ScaledThresholds;
+
+        constexpr std::array floatKeys = {
+            FloatKey{"Climb", "MinHeight", &T::climbMinHeight},
+            FloatKey{"Climb", "MaxHeight", &T::climbMaxHeight},
+            FloatKey{"Vault", "MinHeight", &T::vaultMinHeight},
+            FloatKey{"Vault", "MaxHeight", &T::vaultMaxHeight},
+            FloatKey{"Vault", "MaxElevationIncrease", &T::vaultMaxElevationIncrease},
+            FloatKey{"Vault", "Length", &T::vaultLength},
+            FloatKey{"Vault", "HeadHeight", &T::vaultHeadHeight},
+            FloatKey{"Vault", "ObstructionDistance", &T::vaultObstructionDist},
+            FloatKey{"Vault", "DownStep", &T::vaultDownStep},
+            FloatKey{"Bands", "HighestLedgeLimit", &T::highestLedgeLimit},
+            FloatKey{"Bands", "HighLedgeLimit", &T::highLedgeLimit},
+            FloatKey{"Bands", "MedLedgeLimit", &T::medLedgeLimit},
+            FloatKey{"Bands", "LowLedgeLimit", &T::lowLedgeLimit},
+            FloatKey{"Bands", "HighStepLimit", &T::highStepLimit},
+            FloatKey{"Bands", "GrabMaxHeight", &T::grabMaxHeight},
+            FloatKey{"Ledge", "StartZOffset", &T::ledgeStartZOffset},
+            FloatKey{"Ledge", "MinUpCheck", &T::ledgeMinUpCheck},
+            FloatKey{"Ledge", "UpCheckMargin", &T::ledgeUpCheckMargin},
+            FloatKey{"Ledge", "ForwardStep", &T::ledgeForwardStep},
+            FloatKey{"Ledge", "ObstructionDistance", &T::ledgeObstructionDist},
+            FloatKey{"Ledge", "StandingHeight", &T::standingHeight},
+            FloatKey{"Ledge", "HeadroomBuffer", &T::headroomBuffer},
+            FloatKey{"Ledge", "ClearanceRadius", &T::clearanceRadius},
+            FloatKey{"Ledge", "MinFlatness", &T::minLedgeFlatness},
+            FloatKey{"Heading", "DistanceWeight", &T::headingDistanceWeight},
+            FloatKey{"Grab", "Horizon", &T::grabHorizon},
+            FloatKey{"Grab", "Gravity", &T::grabGravity},
+            FloatKey{"Grab", "PathTolerance", &T::grabPathTolerance},
+            FloatKey{"Quality", "DownMs", &T::qualityDownMs},
+            FloatKey{"Quality", "UpMs", &T::qualityUpMs},
+            FloatKey{"Position", "BackwardOffset", &T::backwardOffset},
+            FloatKey{"Position", "StepBackwardOffset", &T::stepBackwardOffset},
+            FloatKey{"Position", "GrabBackwardOffset", &T::grabBackwardOffset},
+            FloatKey{"Elevation", "Highest", &T::highestLedgeElevation},
+            FloatKey{"Elevation", "High", &T::highLedgeElevation},
+            FloatKey{"Elevation", "Medium", &T::medLedgeElevation},
+            FloatKey{"Elevation", "Low", &T::lowLedgeElevation},
+            FloatKey{"Elevation", "StepHigh", &T::stepHighElevation},
+            FloatKey{"Elevation", "StepLow", &T::stepLowElevation},
+            FloatKey{"Elevation", "Vault", &T::vaultElevation},
+            FloatKey{"Elevation", "Grab", &T::grabElevation},
+        };
+
+        constexpr std::array intKeys = {
+            IntKey{"Ledge", "ForwardIterations", &T::ledgeForwardIterations, 1, 64},
+            IntKey{"Ledge", "ForwardSearch", &T::ledgeForwardSearch, ProbeSearch::Linear, ProbeSearch::Adaptive},
+            IntKey{"Ledge", "ClearanceCheck", &T::ledgeClearance, ClearanceCheck::Ray, ClearanceCheck::Sweep},
+            IntKey{"Vault", "DownIterations", &T::vaultDownIterations, 1, static_cast<int>(RayBatch::kCapacity)},
+            IntKey{"Heading", "Count", &T::headingCount, 1, 32},
+            IntKey{"Heading", "RayBudget", &T::headingRayBudget, 1, 4096},
+            IntKey{"Grab", "Prediction", &T::grabPrediction, 0, 1},
+            IntKey{"Cache", "TtlMs", &T::cacheTtlMs, 0, 10000},
+            IntKey{"Cache", "Negative", &T::negativeCache, NegativeCacheMode::Off, NegativeCacheMode::Confirm},
+            IntKey{"Budget", "FrameCasts", &T::sliceCasts, 0, 4096},
+            IntKey{"Budget", "FrameMicroseconds", &T::sliceMicroseconds, 0, 100000},
+            IntKey{"Quality", "Tier", &T::quality, DetectionQuality::Custom, DetectionQuality::Auto},
+        };
+
+        std::string_view Trim(std::string_view text) {
+            const auto first = text.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos) {
+                return {};
+            }
+            const auto last = text.find_last_not_of(" \t\r");
+            return text.substr(first, last - first + 1);
+        }
+
+        template <class Number>
+        bool ParseNumber(std::string_view token, Number &out) {
+            const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), out);
+            return ec == std::errc() && ptr == token.data() + token.size();
+        }
+
+        std::string LineError(int lineNumber, std::string_view message) {
+            return "line " + std::to_string(lineNumber) + ": " + std::string(message);
+        }
+    }  // namespace
+
+    bool Parse(std::string_view text, File &out, std::string &errorOut) {
+        File file;
+        std::string section;
+        int lineNumber = 0;
+
+        while (!text.empty()) {
+            const auto newline = text.find('\n');
+            std::string_view line = text.substr(0, newline);
+            text = newline == std::string_view::npos ? std::string_view{} : text.substr(newline + 1);
+            lineNumber++;
+
+            if (const auto comment = line.find_first_of("#;"); comment != std::string_view::npos) {
+                line = line.substr(0, comment);
+            }
+            line = Trim(line);
+            if (line.empty()) {
+                continue;
+            }
+
+            if (line.front() == '[') {
+                if (line.back() != ']') {
+                    errorOut = LineError(lineNumber, "unterminated section");
+                    return false;
+                }
+                section = Trim(line.substr(1, line.size() - 2));
+                continue;
+            }
+
+            const auto equals = line.find('=');
+            if (equals == std::string_view::npos) {
+                errorOut = LineError(lineNumber, "expected key = value");
+                return false;
+            }
+            const auto key = Trim(line.substr(0, equals));
+            const auto value = Trim(line.substr(equals + 1));
+
+            bool known = false;
+            if (section == "General" && key == "HotReload") {
+                int flag = 0;
+                if (!ParseNumber(value, flag) || (flag != 0 && flag != 1)) {
+                    errorOut = LineError(lineNumber, "HotReload must be 0 or 1");
+                    return false;
+                }
+                file.hotReload = flag == 1;
+                known = true;
+            }
+            for (const auto &entry: floatKeys) {
+                if (entry.section == section && entry.key == key) {
+                    float number = 0.0f;
+                    if (!ParseNumber(value, number) || !std::isfinite(number) || number < 0.0f) {
+                        errorOut = LineError(lineNumber, "bad value for " + std::string(key));
+                        return false;
+                    }
+                    file.thresholds.*entry.field = number;
+                    known = true;
+                }
+            }
+            for (const auto &entry: intKeys) {
+                if (entry.section == section && entry.key == key) {
+                    int number = 0;
+                    if (!ParseNumber(value, number) || number < entry.min || number > entry.max) {
+                        errorOut = LineError(lineNumber, std::string(key) + " must be " + std::to_string(entry.min) + ".." +
+                                                             std::to_string(entry.max));
+                        return false;
+                    }
+                    file.thresholds.*entry.field = number;
+                    known = true;
+                }
+            }
+            if (!known) {
+                errorOut = LineError(lineNumber, "unknown key [" + section + "] " + std::string(key));
+                return false;
+            }
+        }
+
+        out = file;
+        return true;
+    }
+
+    bool LoadFile(const std::filesystem::path &path, File &out, std::string &errorOut) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input) {
+            errorOut = "can't open " + path.string();
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << input.rdbuf();
+        return Parse(buffer.str(), out, errorOut);
+    }
+
+    std::string Format(const File &file) {
+        std::ostringstream text;
+        text << "[General]\nHotReload = " << (file.hotReload ? 1 : 0) << '\n';
+
+        std::string_view section = "General";
+        const auto beginSection = [&](std::string_view name) {
+            if (name != section) {
+                section = name;
+                text << "\n[" << name << "]\n";
+            }
+        };
+
+        // Sections in the order the tables first name them, so a key added to either table is always written
+        std::vector<std::string_view> sections;
+        const auto addSection = [&sections](std::string_view name) {
+            if (std::find(sections.begin(), sections.end(), name) == sections.end()) {
+                sections.push_back(name);
+            }
+        };
+        for (const auto &entry: floatKeys) {
+            addSection(entry.section);
+        }
+        for (const auto &entry: intKeys) {
+            addSection(entry.section);
+        }
+
+        for (const auto name: sections) {
+            for (const auto &entry: floatKeys) {
+                if (entry.section == name) {
+                    // Shortest text that parses back to the same float
+                    std::array<char, 32> number;
+                    const auto written = std::to_chars(number.data(), number.data() + number.size(), file.thresholds.*entry.field);
+                    beginSection(name);
+                    text << entry.key << " = " << std::string_view(number.data(), written.ptr) << '\n';
+                }
+            }
+            for (const auto &entry: intKeys) {
+                if (entry.section == name) {
+                    beginSection(name);
+                    text << entry.key << " = " << file.thresholds.*entry.field << '\n';
+                }
+            }
+        }
+        return text.str();
+    }
+
+    Store::Store()
+        : current(nullptr) {
+        Publish(ScaledThresholds{});
+    }
+
+    void Store::Publish(const ScaledThresholds &thresholds) {
+        std::scoped_lock guard(writeLock);
+        snapshots.push_back(std::make_unique<const ScaledThresholds>(thresholds));
+        current.store(snapshots.back().get(), std::memory_order_release);
+        version.fetch_add(1, std::memory_order_acq_rel);
+    }
+}  // namespace ParkourCore::Tuning
@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <string>
+
+#include "ParkourCore/DetectionCache.h"
+#include "ParkourCore/SceneLibrary.h"
+#include "TestUtil.h"
+
+// A cached decision has to be the decision detection makes for the pose asked about, never a neighbour's.
+
+using namespace ParkourCore;
+
+// Every corpus pose idling at 60 fps with a sub-unit shuffle and a slight turn now and then, cache on against off
+TEST(CachedMatchesUncached) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    DetectionCache cache;
+    std::uint32_t cellId = 0;
+    std::uint64_t hits = 0;
+    for (const auto &pose: Test::CorpusPoses(corpus)) {
+        cache.SetContext(++cellId, pose.player.scale);
+        const auto before = cache.GetStats().hits;
+        for (int frame = 0; frame < 60; frame++) {
+            PlayerState player = pose.player;
+            player.position.x += 0.01f * static_cast<float>(frame / 8 % 3);
+            player.position.y += 0.01f * static_cast<float>(frame / 12 % 2);
+            player.yaw += 0.0005f * static_cast<float>(frame / 10 % 3);
+            const auto nowMs = static_cast<std::uint64_t>(frame) * 16;
+
+            const auto cached = cache.GetLedgePoint(pose.sceneCase->scene, player, pose.thresholds, true, nowMs);
+            const auto fresh = GetLedgePoint(pose.sceneCase->scene, player, pose.thresholds, true);
+            CHECK_MESSAGE(Test::SameResult(cached, fresh), pose.name + " frame " + std::to_string(frame) + ": " + Test::Describe(cached) +
+                                                               ", fresh " + Test::Describe(fresh));
+        }
+        hits += cache.GetStats().hits - before;
+    }
+    CHECK(hits > 0);  // Still a cache
+}
+
+// The same pose a moment later is answered, a hundredth of a unit away is not
+TEST(OnlyTheSamePoseHits) {
+    auto scene = SceneLibrary::Wall(128.0f);
+    PlayerState player;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    DetectionCache cache;
+    cache.SetContext(1, player.scale);
+
+    cache.GetLedgePoint(scene, player, thresholds, true, 0);
+    cache.GetLedgePoint(scene, player, thresholds, true, 16);
+    CHECK(cache.GetStats().hits == 1);
+
+    player.position.x += 0.01f;
+    cache.GetLedgePoint(scene, player, thresholds, true, 32);
+    CHECK(cache.GetStats().hits == 1);
+
+    // Past the time to live
+    cache.GetLedgePoint(scene, player, thresholds, true, 32 + cache.Config().ttlMs + 1);
+    CHECK(cache.GetStats().hits == 1);
+}
+
+int main() {
+    return Test::RunAll();
+}
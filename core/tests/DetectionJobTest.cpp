@@ -0,0 +1,81 @@
+#include <string>
+#include <vector>
+
+#include "ParkourCore/CountingWorldQuery.h"
+#include "ParkourCore/DetectionJob.h"
+#include "ParkourCore/QualityTier.h"
+#include "TestUtil.h"
+
+// A job stepped under any budget has to decide what one GetLedgePoint decides with the same casts, every search
+// included, and no slice may cast more than the budget allows.
+
+using namespace ParkourCore;
+
+namespace {
+    template <class F>
+    void CheckMatchesSync(std::vector<SceneLibrary::Case> &corpus, F &&configure) {
+        for (const auto &pose: Test::CorpusPoses(corpus)) {
+            auto thresholds = pose.thresholds;
+            configure(thresholds);
+
+            CountingWorldQuery syncWorld(pose.sceneCase->scene);
+            const auto sync = GetLedgePoint(syncWorld, pose.player, thresholds, true);
+
+            for (const int casts: {1, 3, 4, 7}) {
+                CountingWorldQuery jobWorld(pose.sceneCase->scene);
+                DetectionJob job;
+                job.Start(pose.player, thresholds, true);
+                while (!job.Step(jobWorld, {casts, 0})) {
+                }
+
+                const std::string where = pose.name + " at " + std::to_string(casts) + " casts: ";
+                CHECK_MESSAGE(Test::SameResult(job.Result(), sync),
+                              where + Test::Describe(job.Result()) + ", GetLedgePoint found " + Test::Describe(sync));
+                CHECK_MESSAGE(job.Casts() == syncWorld.rays + syncWorld.sweeps && jobWorld.rays + jobWorld.sweeps == job.Casts(),
+                              where + std::to_string(job.Casts()) + " casts, GetLedgePoint made " +
+                                  std::to_string(syncWorld.rays + syncWorld.sweeps));
+                CHECK_MESSAGE(job.GetStats().maxSliceCasts <= static_cast<std::uint32_t>(casts),
+                              where + "a slice made " + std::to_string(job.GetStats().maxSliceCasts));
+            }
+        }
+    }
+}  // namespace
+
+TEST(LinearMatchesSync) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    CheckMatchesSync(corpus, [](ScaledThresholds &) {});
+}
+
+TEST(TiersMatchSync) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    for (const int tier: {DetectionQuality::Low, DetectionQuality::Medium, DetectionQuality::High}) {
+        CheckMatchesSync(corpus, [&](ScaledThresholds &t) { t = WithQuality(t, tier); });
+    }
+}
+
+TEST(AdaptiveMatchesSync) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    CheckMatchesSync(corpus, [](ScaledThresholds &t) { t.ledgeForwardSearch = ProbeSearch::Adaptive; });
+}
+
+TEST(SweepMatchesSync) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    CheckMatchesSync(corpus, [](ScaledThresholds &t) { t.ledgeClearance = ClearanceCheck::Sweep; });
+}
+
+// A time budget lets whole batches through, the first cast of a slice always goes out
+TEST(TimeBudgetFinishes) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    for (const auto &pose: Test::CorpusPoses(corpus)) {
+        const auto sync = GetLedgePoint(pose.sceneCase->scene, pose.player, pose.thresholds, true);
+        DetectionJob job;
+        job.Start(pose.player, pose.thresholds, true);
+        while (!job.Step(pose.sceneCase->scene, {0, 1})) {
+        }
+        CHECK_MESSAGE(Test::SameResult(job.Result(), sync), pose.name + ": " + Test::Describe(job.Result()));
+    }
+}
+
+int main() {
+    return Test::RunAll();
+}
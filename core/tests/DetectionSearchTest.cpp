@@ -0,0 +1,51 @@
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/QualityTier.h"
+#include "ParkourCore/SceneLibrary.h"
+#include "TestUtil.h"
+
+// Every alternative probe search has to decide what the linear default decides, on every corpus pose.
+
+using namespace ParkourCore;
+
+namespace {
+    template <class F>
+    void CheckMatchesLinear(F &&configure) {
+        auto corpus = SceneLibrary::StandardCorpus();
+        for (const auto &pose: Test::CorpusPoses(corpus)) {
+            auto thresholds = pose.thresholds;
+            configure(thresholds);
+
+            const auto linear = GetLedgePoint(pose.sceneCase->scene, pose.player, pose.thresholds, true);
+            const auto result = GetLedgePoint(pose.sceneCase->scene, pose.player, thresholds, true);
+            CHECK_MESSAGE(Test::SameResult(result, linear),
+                          pose.name + ": " + Test::Describe(result) + ", linear found " + Test::Describe(linear));
+        }
+    }
+}  // namespace
+
+// High runs the default counts through the loops unrolled at compile time
+TEST(UnrolledMatchesLinear) {
+    CheckMatchesLinear([](ScaledThresholds &t) { t.quality = DetectionQuality::High; });
+}
+
+// Auto only steps between tiers that lose nothing against the tuned counts
+TEST(AutoTiersMatchLinear) {
+    for (int tier = QualityGovernor::lowestTier; tier <= DetectionQuality::High; tier++) {
+        CheckMatchesLinear([&](ScaledThresholds &t) { t = WithQuality(t, tier); });
+    }
+}
+
+TEST(AdaptiveForwardMatchesLinear) {
+    CheckMatchesLinear([](ScaledThresholds &t) { t.ledgeForwardSearch = ProbeSearch::Adaptive; });
+}
+
+TEST(AdaptiveForwardUnrolledMatchesLinear) {
+    CheckMatchesLinear([](ScaledThresholds &t) {
+        t.ledgeForwardSearch = ProbeSearch::Adaptive;
+        t.quality = DetectionQuality::High;
+    });
+}
+
+int main() {
+    return Test::RunAll();
+}
@@ -0,0 +1,140 @@
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "ParkourCore/GrabPrediction.h"
+#include "ParkourCore/SceneLibrary.h"
+#include "TestUtil.h"
+
+// The predicted window has to be where detection along the predicted path finds the Grab, and the predictor may only
+// keep a prediction while the player follows its path.
+
+using namespace ParkourCore;
+
+namespace {
+    // Running at a wall, jumping with jumpSpeed, or falling from 60 under its top without one
+    PlayerState Jumper(float height, float backOff, float jumpSpeed) {
+        PlayerState player;
+        player.position = Vec3(0, -backOff, jumpSpeed == 0.0f ? height - 60.0f : 0.0f);
+        player.velocity = Vec3(0, 150.0f, jumpSpeed);
+        player.isMoving = true;
+        player.isGroundedOrSliding = false;
+        player.isMidairAndNotSliding = true;
+        return player;
+    }
+
+    std::string Name(float height, float backOff, float jumpSpeed) {
+        return "wall " + std::to_string(static_cast<int>(height)) + " back " + std::to_string(static_cast<int>(backOff)) + " jump " +
+               std::to_string(static_cast<int>(jumpSpeed));
+    }
+}  // namespace
+
+// Detection from every path sample inside the window finds the Grab, and not from more than a sample before it opens
+TEST(WindowMatchesDetection) {
+    int grabs = 0;
+    for (const float height: {140.0f, 175.0f, 190.0f, 225.0f}) {
+        auto scene = SceneLibrary::Wall(height);
+        for (const float backOff: {40.0f, 100.0f}) {
+            for (const float jumpSpeed: {0.0f, 250.0f, 400.0f}) {
+                const auto player = Jumper(height, backOff, jumpSpeed);
+                const auto thresholds = ScaledThresholds::ForScale(player.scale);
+                const auto prediction = PredictGrab(scene, player, thresholds);
+                const auto name = Name(height, backOff, jumpSpeed);
+                if (!prediction.HasGrab()) {
+                    continue;
+                }
+                grabs++;
+                CHECK_MESSAGE(prediction.result.ledgeType == ParkourType::Grab, name);
+                CHECK_MESSAGE(prediction.timeToContact < prediction.windowEnd, name);
+                CHECK_MESSAGE(prediction.windowEnd <= static_cast<float>(prediction.pathSteps + 1) * grabPredictionStep, name);
+
+                for (int i = 0; i <= prediction.pathSteps; i++) {
+                    const float seconds = static_cast<float>(i) * grabPredictionStep;
+                    PlayerState atSample = player;
+                    atSample.position = prediction.path[i];
+                    const auto detected = GetLedgePoint(scene, atSample, thresholds, true);
+                    if (seconds >= prediction.timeToContact && seconds <= prediction.windowEnd) {
+                        CHECK_MESSAGE(detected.ledgeType == ParkourType::Grab,
+                                      name + " sample " + std::to_string(i) + " in the window: " + Test::Describe(detected));
+                    }
+                    else if (seconds < prediction.timeToContact - 1.5f * grabPredictionStep) {
+                        CHECK_MESSAGE(detected.ledgeType != ParkourType::Grab, name + " sample " + std::to_string(i) + " before the window");
+                    }
+                }
+            }
+        }
+    }
+    CHECK(grabs >= 8);
+}
+
+// Nothing to grab on open ground, and nothing predicted on the ground
+TEST(NoGrabWithoutALedge) {
+    auto flat = SceneLibrary::Flat();
+    const auto player = Jumper(0.0f, 40.0f, 400.0f);
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    CHECK(!PredictGrab(flat, player, thresholds).HasGrab());
+
+    auto wall = SceneLibrary::Wall(140.0f);
+    PlayerState grounded = Jumper(140.0f, 40.0f, 400.0f);
+    grounded.isMidairAndNotSliding = false;
+    grounded.isGroundedOrSliding = true;
+    const auto prediction = PredictGrab(wall, grounded, thresholds);
+    CHECK(!prediction.HasGrab() && prediction.pathSteps == 0);
+}
+
+// Following the path within grabPathTolerance keeps the prediction and its window, straying further predicts again
+TEST(ReusesAlongThePath) {
+    auto scene = SceneLibrary::Wall(175.0f);
+    const auto player = Jumper(175.0f, 40.0f, 400.0f);
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+
+    GrabPredictor predictor;
+    const auto first = predictor.Update(scene, player, thresholds, 1000);
+    CHECK(first.HasGrab());
+    CHECK(predictor.GetStats().predictions == 1);
+    const auto opensMs = predictor.MsUntilWindow(1000);
+    CHECK(opensMs > 0);
+    CHECK(predictor.Due(1000) == nullptr);
+
+    PlayerState onPath = player;
+    onPath.position = first.PathPosition(0.1f) + Vec3(thresholds.grabPathTolerance - 1.0f, 0, 0);
+    predictor.Update(scene, onPath, thresholds, 1100);
+    CHECK(predictor.GetStats().reuses == 1);
+    CHECK(predictor.GetStats().predictions == 1);
+    CHECK(std::abs(predictor.MsUntilWindow(1100) - (opensMs - 100)) <= 1);  // Rounded up to whole milliseconds
+
+    const auto openAt = 1000 + static_cast<std::uint64_t>(opensMs);
+    CHECK(predictor.Due(openAt) != nullptr);
+    CHECK(predictor.Due(1000 + static_cast<std::uint64_t>(first.windowEnd * 1000.0f) + 1) == nullptr);
+
+    PlayerState offPath = player;
+    offPath.position = first.PathPosition(0.15f) + Vec3(thresholds.grabPathTolerance + 1.0f, 0, 0);
+    predictor.Update(scene, offPath, thresholds, 1150);
+    CHECK(predictor.GetStats().predictions == 2);
+}
+
+// Landing drops the prediction, the next jump predicts from scratch
+TEST(LandingResets) {
+    auto scene = SceneLibrary::Wall(175.0f);
+    const auto player = Jumper(175.0f, 40.0f, 400.0f);
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+
+    GrabPredictor predictor;
+    predictor.Update(scene, player, thresholds, 0);
+    CHECK(predictor.MsUntilWindow(0) > 0);
+
+    PlayerState landed = player;
+    landed.isMidairAndNotSliding = false;
+    landed.isGroundedOrSliding = true;
+    CHECK(!predictor.Update(scene, landed, thresholds, 50).HasGrab());
+    CHECK(predictor.MsUntilWindow(50) == -1);
+    CHECK(predictor.Due(400) == nullptr);
+
+    predictor.Update(scene, player, thresholds, 100);
+    CHECK(predictor.GetStats().predictions == 2);
+    CHECK(predictor.GetStats().reuses == 0);
+}
+
+int main() {
+    return Test::RunAll();
+}
@@ -0,0 +1,96 @@
+#include <cmath>
+#include <numbers>
+#include <optional>
+#include <string>
+
+#include "ParkourCore/HeadingScan.h"
+#include "ParkourCore/SceneLibrary.h"
+#include "TestUtil.h"
+
+// HeadingTracker may skip scans, but what it skips has to be what a fresh scan would pick again.
+
+using namespace ParkourCore;
+
+namespace {
+    // A climbable block beside a path along +Y, nothing ahead
+    CollisionScene SideLedge() {
+        CollisionScene scene;
+        SceneLibrary::AddGround(scene);
+        scene.AddBox({40.0f, 300.0f, 0.0f}, {200.0f, 400.0f, 80.0f}, CollisionLayer::kStatic);
+        scene.Build();
+        return scene;
+    }
+}  // namespace
+
+// Standing with the same input, the first scan holds
+TEST(StandingKeepsTheScan) {
+    auto scene = SceneLibrary::Wall(128.0f);
+    PlayerState player;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    const Vec3 inputDir = DirFlatFromYaw(0.0f);
+
+    HeadingTracker tracker;
+    for (int update = 0; update < 5; update++) {
+        std::optional<HeadingScanResult> scan;
+        tracker.Update(scene, player, thresholds, true, inputDir, scan);
+        CHECK(scan.has_value() == (update == 0));
+    }
+    CHECK(tracker.GetStats().scans == 1);
+}
+
+// A new input sector scans again, a small wobble inside the sector doesn't
+TEST(TurningTheInputScans) {
+    auto scene = SceneLibrary::Wall(128.0f);
+    PlayerState player;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+
+    HeadingTracker tracker;
+    std::optional<HeadingScanResult> scan;
+    tracker.Update(scene, player, thresholds, true, DirFlatFromYaw(0.0f), scan);
+    tracker.Update(scene, player, thresholds, true, DirFlatFromYaw(0.05f), scan);
+    CHECK(!scan.has_value());
+    tracker.Update(scene, player, thresholds, true, DirFlatFromYaw(std::numbers::pi_v<float> / 2.0f), scan);
+    CHECK(scan.has_value());
+}
+
+// Walking past a ledge to the side with the input fixed ahead. The scan at the start finds nothing, later ones have to
+// see the block come into reach and turn to it, and turn back once it is behind.
+TEST(WalkingPastASideLedgeRescans) {
+    auto scene = SideLedge();
+    PlayerState player;
+    player.isMoving = true;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    const Vec3 inputDir = DirFlatFromYaw(0.0f);
+
+    HeadingTracker tracker;
+    int foundUpdates = 0;
+    int freshFoundUpdates = 0;
+    float lastYaw = 0.0f;
+    for (int update = 0; update <= 150; update++) {
+        PlayerState state = player;
+        state.position.y = 4.0f * static_cast<float>(update);  // 240 units/s at 60 fps
+
+        std::optional<HeadingScanResult> scan;
+        state.yaw = tracker.Update(scene, state, thresholds, true, inputDir, scan);
+        const auto tracked = GetLedgePoint(scene, state, thresholds, true);
+        const auto fresh = ScanHeadings(scene, state, thresholds, true, inputDir);
+        foundUpdates += tracked.ledgeType != ParkourType::NoLedge;
+        freshFoundUpdates += fresh.best.ledgeType != ParkourType::NoLedge;
+        if (scan) {
+            CHECK_MESSAGE(Test::SameResult(scan->best, fresh.best),
+                          "update " + std::to_string(update) + ": " + Test::Describe(scan->best) + ", fresh " + Test::Describe(fresh.best));
+        }
+        lastYaw = state.yaw;
+    }
+
+    CHECK(freshFoundUpdates > 0);
+    // Rescans every ledgeForwardStep, two updates at this speed, so the tracker trails a fresh scan by at most one
+    CHECK_MESSAGE(foundUpdates * 3 >= freshFoundUpdates * 2,
+                  "tracked " + std::to_string(foundUpdates) + " of " + std::to_string(freshFoundUpdates) + " updates a fresh scan finds");
+    CHECK(std::abs(lastYaw) < 0.001f);  // Past the block, back along the input
+    CHECK(tracker.GetStats().scans > 1);
+}
+
+int main() {
+    return Test::RunAll();
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ParkourCore/LedgeIndexBaker.h"
+#include "ParkourCore/SceneLibrary.h"
+#include "TestUtil.h"
+
+// Bakes every corpus scene in memory. A rebake must give the same bytes, the adopted view must read back what was
+// baked, and damaged bytes must be refused.
+
+using namespace ParkourCore;
+
+TEST(RebakeIsDeterministic) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    for (auto &sceneCase: corpus) {
+        CHECK_MESSAGE(BakeLedgeIndex(sceneCase.scene, {}) == BakeLedgeIndex(sceneCase.scene, {}), sceneCase.name);
+    }
+}
+
+// The adopted view reads back every baked ledge in place
+TEST(AdoptedMatchesBake) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    std::string error;
+    for (std::size_t i = 0; i < corpus.size(); i++) {
+        LedgeBakeSettings settings;
+        settings.cellKey = static_cast<std::uint32_t>(i + 1);
+        const auto bytes = BakeLedgeIndex(corpus[i].scene, settings);
+
+        LedgeIndex index;
+        const bool adopted = index.Adopt(bytes, error);
+        CHECK_MESSAGE(adopted, corpus[i].name + ": " + error);
+        if (!adopted) {
+            continue;
+        }
+        const auto &view = index.View();
+        const auto read = std::as_bytes(view.Ledges());
+        const auto baked = std::span(bytes).subspan(view.Header().ledgeOffset, read.size());
+        CHECK_MESSAGE(view.Header().cellKey == settings.cellKey && std::equal(read.begin(), read.end(), baked.begin(), baked.end()),
+                      corpus[i].name);
+    }
+}
+
+// Open checks the header and the tables once, so damaged bytes must not get through it
+TEST(DamagedIsRefused) {
+    auto scene = SceneLibrary::Wall(123.0f);
+    const auto bytes = BakeLedgeIndex(scene, {});
+    std::string error;
+    const auto refused = [&](std::vector<std::byte> damaged) {
+        LedgeIndex index;
+        return !index.Adopt(std::move(damaged), error);
+    };
+
+    CHECK(!refused(bytes));
+    CHECK(refused({bytes.begin(), bytes.end() - 4}));
+    auto badMagic = bytes;
+    badMagic[0] = std::byte{0};
+    CHECK(refused(badMagic));
+    auto badVersion = bytes;
+    badVersion[offsetof(LedgeIndexHeader, version)] = std::byte{99};
+    CHECK(refused(badVersion));
+    auto badTable = bytes;
+    badTable[offsetof(LedgeIndexHeader, cellsX)] = std::byte{0xff};
+    CHECK(refused(badTable));
+}
+
+int main() {
+    return Test::RunAll();
+}
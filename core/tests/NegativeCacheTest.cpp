@@ -0,0 +1,167 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ParkourCore/NegativeCache.h"
+#include "ParkourCore/SceneLibrary.h"
+#include "TestUtil.h"
+
+// A remembered NoLedge may only answer while it is fresh and its confirm rays still see the same world, and a miss
+// with something climbable just past reach must never be remembered.
+
+using namespace ParkourCore;
+
+namespace {
+    // Distinct keys on open ground, one position cell apart
+    std::vector<PlayerState> Poses(int count, const NegativeCacheConfig &config) {
+        std::vector<PlayerState> poses;
+        for (int i = 0; i < count; i++) {
+            PlayerState player;
+            player.position.x = (static_cast<float>(i % 32) + 0.5f) * config.positionStep;
+            player.position.y = (static_cast<float>(i / 32) + 0.5f) * config.positionStep;
+            poses.push_back(player);
+        }
+        return poses;
+    }
+}  // namespace
+
+TEST(FreshEntryHits) {
+    auto scene = SceneLibrary::Flat();
+    PlayerState player;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    NegativeCache cache;
+    const auto key = cache.MakeKey(player, true);
+
+    CHECK(!cache.Check(scene, player, thresholds, key, 0));
+    cache.Store(scene, player, thresholds, key, 40, 0);
+    CHECK(cache.GetStats().stores == 1);
+    CHECK(cache.Check(scene, player, thresholds, key, 16));
+    CHECK(cache.GetStats().hits == 1);
+    CHECK(cache.GetStats().raysSaved == 40 - 3);  // The confirm rays are not free
+}
+
+// Still answers at ttlMs, not a millisecond later, and an expired entry is dropped
+TEST(ExpiresAfterTtl) {
+    auto scene = SceneLibrary::Flat();
+    PlayerState player;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    NegativeCache cache;
+    const auto key = cache.MakeKey(player, true);
+    const std::uint64_t ttl = cache.Config().ttlMs;
+
+    cache.Store(scene, player, thresholds, key, 40, 100);
+    CHECK(cache.Check(scene, player, thresholds, key, 100 + ttl));
+    CHECK(!cache.Check(scene, player, thresholds, key, 100 + ttl + 1));
+    CHECK(cache.GetStats().expired == 1);
+    CHECK(!cache.Check(scene, player, thresholds, key, 100));
+    CHECK(cache.GetStats().expired == 1);  // Gone, not expired again
+}
+
+// A wall in front that wasn't there when the miss was stored moves the face ray
+TEST(ConfirmMismatchDropsTheEntry) {
+    auto flat = SceneLibrary::Flat();
+    auto wall = SceneLibrary::Wall(300.0f);
+    PlayerState player;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    NegativeCache cache;
+    const auto key = cache.MakeKey(player, true);
+
+    cache.Store(flat, player, thresholds, key, 40, 0);
+    CHECK(!cache.Check(wall, player, thresholds, key, 16));
+    CHECK(cache.GetStats().confirmFailures == 1);
+    CHECK(!cache.Check(flat, player, thresholds, key, 32));  // The wall going away doesn't bring it back
+    CHECK(cache.GetStats().hits == 0);
+}
+
+// A block in the climb band just past the forward probes' reach, a step across the cell brings it into reach
+TEST(RefusesAMissWithALedgeJustPastReach) {
+    PlayerState player;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    const float reach = thresholds.ledgeForwardStep * static_cast<float>(thresholds.ledgeForwardIterations - 1);
+    CollisionScene block;
+    SceneLibrary::AddGround(block);
+    block.AddBox({-100.0f, reach + 4.0f, 0.0f}, {100.0f, reach + 60.0f, 100.0f}, CollisionLayer::kStatic);
+    block.Build();
+    auto flat = SceneLibrary::Flat();
+
+    NegativeCache cache;
+    const auto key = cache.MakeKey(player, true);
+    cache.Store(flat, player, thresholds, key, 40, 0);
+    CHECK(cache.GetStats().stores == 1);
+
+    cache.Store(block, player, thresholds, key, 40, 16);
+    CHECK(cache.GetStats().refused == 1);
+    CHECK(cache.GetStats().stores == 1);
+    CHECK(!cache.Check(flat, player, thresholds, key, 32));  // The earlier miss under the same key is gone too
+}
+
+// More live keys than the table holds: the oldest go, never more than setCount * ways stay
+TEST(FullSetsEvictTheOldest) {
+    auto scene = SceneLibrary::Flat();
+    NegativeCacheConfig config;
+    config.ttlMs = 60000;  // A store a millisecond, none expire
+    NegativeCache cache(config);
+    const auto thresholds = ScaledThresholds::ForScale(1.0f);
+    constexpr int capacity = static_cast<int>(NegativeCache::setCount * NegativeCache::ways);
+    const auto poses = Poses(capacity * 4, cache.Config());  // Enough that every set overflows
+
+    for (std::size_t i = 0; i < poses.size(); i++) {
+        cache.Store(scene, poses[i], thresholds, cache.MakeKey(poses[i], true), 40, i);
+    }
+    CHECK(cache.GetStats().stores == poses.size());
+    CHECK(cache.GetStats().evictions >= poses.size() - capacity);
+
+    const std::uint64_t nowMs = poses.size();
+    int live = 0;
+    for (const auto &pose: poses) {
+        live += cache.Check(scene, pose, thresholds, cache.MakeKey(pose, true), nowMs);
+    }
+    CHECK(live == static_cast<int>(poses.size() - cache.GetStats().evictions));
+    CHECK(live <= capacity);
+    // The first key is the oldest in its set, the last the newest
+    CHECK(!cache.Check(scene, poses.front(), thresholds, cache.MakeKey(poses.front(), true), nowMs));
+    CHECK(cache.Check(scene, poses.back(), thresholds, cache.MakeKey(poses.back(), true), nowMs));
+}
+
+// Expired ways are taken before a live one is evicted: storing over an expired table evicts exactly what storing into
+// an empty one does
+TEST(ExpiredWaysAreReused) {
+    auto scene = SceneLibrary::Flat();
+    const auto thresholds = ScaledThresholds::ForScale(1.0f);
+    NegativeCache aged;
+    NegativeCache empty;
+    const auto poses = Poses(static_cast<int>(NegativeCache::setCount * NegativeCache::ways) * 2, aged.Config());
+    const std::size_t half = poses.size() / 2;
+
+    for (std::size_t i = 0; i < half; i++) {
+        aged.Store(scene, poses[i], thresholds, aged.MakeKey(poses[i], true), 40, 0);
+    }
+    const auto agedEvictions = aged.GetStats().evictions;
+    const std::uint64_t later = aged.Config().ttlMs + 1;
+    for (std::size_t i = half; i < poses.size(); i++) {
+        aged.Store(scene, poses[i], thresholds, aged.MakeKey(poses[i], true), 40, later);
+        empty.Store(scene, poses[i], thresholds, empty.MakeKey(poses[i], true), 40, later);
+    }
+    CHECK_MESSAGE(aged.GetStats().evictions - agedEvictions == empty.GetStats().evictions,
+                  std::to_string(aged.GetStats().evictions - agedEvictions) + " evictions over expired entries, " +
+                      std::to_string(empty.GetStats().evictions) + " into an empty table");
+}
+
+TEST(ContextChangeInvalidates) {
+    auto scene = SceneLibrary::Flat();
+    PlayerState player;
+    const auto thresholds = ScaledThresholds::ForScale(player.scale);
+    NegativeCache cache;
+    cache.SetContext(1, 1.0f);
+    const auto key = cache.MakeKey(player, true);
+
+    cache.Store(scene, player, thresholds, key, 40, 0);
+    cache.SetContext(1, 1.0f);
+    CHECK(cache.Check(scene, player, thresholds, key, 16));
+    cache.SetContext(2, 1.0f);
+    CHECK(!cache.Check(scene, player, thresholds, key, 32));
+}
+
+int main() {
+    return Test::RunAll();
+}
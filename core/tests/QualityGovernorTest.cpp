@@ -0,0 +1,80 @@
+#include <string>
+
+#include "ParkourCore/QualityTier.h"
+#include "TestUtil.h"
+
+// Auto may only change tier on a sustained average past a threshold, holds a new tier before it looks again, and
+// never drops below QualityGovernor::lowestTier.
+
+using namespace ParkourCore;
+
+namespace {
+    constexpr float downMs = 20.0f;
+    constexpr float upMs = 14.0f;
+
+    // Frames until the tier changes, -1 if it doesn't within limit
+    int FramesUntilChange(QualityGovernor &governor, float frameMs, int limit) {
+        for (int frame = 1; frame <= limit; frame++) {
+            if (governor.AddFrame(frameMs, downMs, upMs)) {
+                return frame;
+            }
+        }
+        return -1;
+    }
+}  // namespace
+
+// A full window of heavy frames steps down as soon as it is full
+TEST(SustainedHeavyFramesStepDown) {
+    QualityGovernor governor;
+    CHECK(FramesUntilChange(governor, 25.0f, QualityGovernor::window) == QualityGovernor::window);
+    CHECK(governor.Tier() == DetectionQuality::Medium);
+    CHECK(governor.GetStats().stepsDown == 1);
+}
+
+// Frames between the two thresholds, or a spike the window averages out, change nothing
+TEST(InsideTheBandHolds) {
+    QualityGovernor governor;
+    CHECK(FramesUntilChange(governor, 17.0f, 1000) == -1);
+
+    governor.Reset();
+    for (int frame = 0; frame < 1000; frame++) {
+        CHECK(!governor.AddFrame(frame % QualityGovernor::window == 0 ? 100.0f : 16.0f, downMs, upMs));
+    }
+    CHECK(governor.Tier() == DetectionQuality::High);
+}
+
+// Back up to High only after holdFrames at Medium and a full window of light frames
+TEST(LightFramesStepUpAfterTheHold) {
+    QualityGovernor governor;
+    FramesUntilChange(governor, 25.0f, QualityGovernor::window);
+    CHECK(governor.Tier() == DetectionQuality::Medium);
+
+    const int frames = FramesUntilChange(governor, 10.0f, 1000);
+    CHECK_MESSAGE(frames == QualityGovernor::holdFrames, "stepped up after " + std::to_string(frames) + " frames");
+    CHECK(governor.Tier() == DetectionQuality::High);
+    CHECK(governor.GetStats().stepsUp == 1);
+}
+
+// Heavy frames alternating with light ones faster than the hold change the tier at most once per hold
+TEST(FlappingIsHeldOff) {
+    QualityGovernor governor;
+    int changes = 0;
+    for (int frame = 0; frame < 10 * QualityGovernor::holdFrames; frame++) {
+        changes += governor.AddFrame((frame / QualityGovernor::window) % 2 == 0 ? 25.0f : 10.0f, downMs, upMs);
+    }
+    CHECK_MESSAGE(changes <= 10, std::to_string(changes) + " changes in 10 holds");
+}
+
+TEST(NeverBelowTheLowestTier) {
+    QualityGovernor governor;
+    CHECK(FramesUntilChange(governor, 100.0f, 100 * QualityGovernor::holdFrames) == QualityGovernor::window);
+    CHECK(FramesUntilChange(governor, 100.0f, 100 * QualityGovernor::holdFrames) == -1);
+    CHECK(governor.Tier() == QualityGovernor::lowestTier);
+
+    governor.Reset(DetectionQuality::Low);
+    CHECK(governor.Tier() == QualityGovernor::lowestTier);
+}
+
+int main() {
+    return Test::RunAll();
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/SceneLibrary.h"
+#include "TestUtil.h"
+
+// Every probe returns its own RayHit and detection keeps no shared state, so probes of two decisions can be mixed in
+// one batch or alternate cast by cast and each decision still sees exactly what it sees run alone.
+
+using namespace ParkourCore;
+
+namespace {
+    struct Probe {
+            Vec3 origin;
+            Vec3 dir;
+            float maxDist = 0.0f;
+            RayHit hit;
+    };
+
+    // Forwards to the scene and keeps every ray it casts with its result. Detection with the default thresholds casts
+    // no sweeps.
+    class RecordingWorldQuery : public WorldQuery {
+        public:
+            explicit RecordingWorldQuery(WorldQuery &a_inner)
+                : inner(a_inner) {}
+
+            void CastBatch(RayBatch &batch) override {
+                BeforeCast();
+                inner.CastBatch(batch);
+                for (std::size_t i = 0; i < batch.Size(); i++) {
+                    probes.push_back({batch.Origin(i), batch.Dir(i), batch.MaxDist(i), batch.results[i]});
+                }
+            }
+
+            RayHit CastRay(const Vec3 &origin, const Vec3 &dir, float maxDist) override {
+                BeforeCast();
+                const RayHit hit = inner.CastRay(origin, dir, maxDist);
+                probes.push_back({origin, dir, maxDist, hit});
+                return hit;
+            }
+
+            std::vector<Probe> probes;
+
+        protected:
+            virtual void BeforeCast() {}
+
+        private:
+            WorldQuery &inner;
+    };
+
+    bool SameHit(const RayHit &a, const RayHit &b) {
+        return a.distance == b.distance && a.normal.x == b.normal.x && a.normal.y == b.normal.y && a.normal.z == b.normal.z &&
+               a.layer == b.layer && a.hitFraction == b.hitFraction && a.valid == b.valid;
+    }
+
+    struct Serial {
+            DetectionResult result;
+            std::vector<Probe> probes;
+    };
+
+    std::vector<Serial> RunSerial(const std::vector<Test::Pose> &poses) {
+        std::vector<Serial> serial;
+        for (const auto &pose: poses) {
+            RecordingWorldQuery recorder(pose.sceneCase->scene);
+            const auto result = GetLedgePoint(recorder, pose.player, pose.thresholds, true);
+            serial.push_back({result, std::move(recorder.probes)});
+        }
+        return serial;
+    }
+
+    // Two threads take turns, one cast each. A thread that is done passes every turn to the other.
+    class Turns {
+        public:
+            void Wait(int player) {
+                std::unique_lock lock(mutex);
+                changed.wait(lock, [&] { return turn == player || done[1 - player]; });
+            }
+            void Pass(int player) {
+                {
+                    std::lock_guard lock(mutex);
+                    turn = 1 - player;
+                }
+                changed.notify_all();
+            }
+            void Done(int player) {
+                {
+                    std::lock_guard lock(mutex);
+                    done[player] = true;
+                }
+                changed.notify_all();
+            }
+
+        private:
+            std::mutex mutex;
+            std::condition_variable changed;
+            int turn = 0;
+            bool done[2] = {false, false};
+    };
+
+    class TurnTakingWorldQuery : public RecordingWorldQuery {
+        public:
+            TurnTakingWorldQuery(WorldQuery &a_inner, Turns &a_turns, int a_player)
+                : RecordingWorldQuery(a_inner), turns(a_turns), player(a_player) {}
+
+            ~TurnTakingWorldQuery() override {
+                if (waiting) {
+                    turns.Pass(player);
+                }
+            }
+
+        protected:
+            // The previous cast is finished once the next one starts, hand the turn over then
+            void BeforeCast() override {
+                if (waiting) {
+                    turns.Pass(player);
+                }
+                turns.Wait(player);
+                waiting = true;
+            }
+
+        private:
+            Turns &turns;
+            int player;
+            bool waiting = false;
+    };
+}  // namespace
+
+// The rays of two decisions alternating in shared batches hit what each of them hit when cast alone
+TEST(InterleavedBatchMatchesSerial) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    const auto poses = Test::CorpusPoses(corpus);
+    const auto serial = RunSerial(poses);
+
+    for (std::size_t a = 0; a < poses.size(); a++) {
+        // A partner decision in the same scene, a different pose
+        const std::size_t b = a % 9 == 8 ? a - 8 : a + 1;
+        const auto &probesA = serial[a].probes;
+        const auto &probesB = serial[b].probes;
+        auto &scene = poses[a].sceneCase->scene;
+
+        std::vector<const Probe *> order;
+        for (std::size_t i = 0; i < std::max(probesA.size(), probesB.size()); i++) {
+            if (i < probesA.size()) {
+                order.push_back(&probesA[i]);
+            }
+            if (i < probesB.size()) {
+                order.push_back(&probesB[i]);
+            }
+        }
+
+        for (std::size_t first = 0; first < order.size(); first += RayBatch::kCapacity) {
+            const std::size_t count = std::min(RayBatch::kCapacity, order.size() - first);
+            RayBatch batch;
+            for (std::size_t i = 0; i < count; i++) {
+                const auto *probe = order[first + i];
+                batch.Add(probe->origin, probe->dir, probe->maxDist);
+            }
+            scene.CastBatch(batch);
+            for (std::size_t i = 0; i < count; i++) {
+                CHECK_MESSAGE(SameHit(batch.results[i], order[first + i]->hit),
+                              poses[a].name + " with " + poses[b].name + ": ray " + std::to_string(first + i) + " differs");
+            }
+        }
+    }
+}
+
+// Two threads run the corpus in opposite orders, taking turns cast by cast. Each decision has to come out as it did
+// run alone, with the same rays and the same hits.
+TEST(InterleavedDetectionMatchesSerial) {
+    auto corpus = SceneLibrary::StandardCorpus();
+    const auto poses = Test::CorpusPoses(corpus);
+    const auto serial = RunSerial(poses);
+
+    Turns turns;
+    std::vector<std::string> failures[2];
+    const auto run = [&](int player) {
+        for (std::size_t k = 0; k < poses.size(); k++) {
+            const std::size_t p = player == 0 ? k : poses.size() - 1 - k;
+            const auto &pose = poses[p];
+            TurnTakingWorldQuery world(pose.sceneCase->scene, turns, player);
+            const auto result = GetLedgePoint(world, pose.player, pose.thresholds, true);
+
+            const auto &expected = serial[p];
+            bool same = Test::SameResult(result, expected.result) && world.probes.size() == expected.probes.size();
+            for (std::size_t i = 0; same && i < world.probes.size(); i++) {
+                same = SameHit(world.probes[i].hit, expected.probes[i].hit);
+            }
+            if (!same) {
+                failures[player].push_back(pose.name + ": " + Test::Describe(result) + ", serial found " + Test::Describe(expected.result));
+            }
+        }
+        turns.Done(player);
+    };
+
+    std::thread other(run, 1);
+    run(0);
+    other.join();
+
+    for (const auto &playerFailures: failures) {
+        for (const auto &failure: playerFailures) {
+            CHECK_MESSAGE(false, failure);
+        }
+    }
+}
+
+int main() {
+    return Test::RunAll();
+}
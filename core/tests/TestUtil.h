@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/SceneLibrary.h"
+
+// Small helpers shared by the test executables. A failed check prints where and what, the executable keeps going and
+// exits non-zero at the end so CTest reports every failure of a run, not just the first.
+namespace Test {
+
+    struct Registry {
+            struct Case {
+                    const char *name;
+                    void (*run)();
+            };
+
+            std::vector<Case> cases;
+            int failures = 0;
+
+            static Registry &Get() {
+                static Registry registry;
+                return registry;
+            }
+    };
+
+    struct Register {
+            Register(const char *name, void (*run)()) {
+                Registry::Get().cases.push_back({name, run});
+            }
+    };
+
+    inline void Fail(const char *file, int line, const std::string &what) {
+        std::fprintf(stderr, "%s:%d: %s\n", file, line, what.c_str());
+        Registry::Get().failures++;
+    }
+
+    // Runs every TEST of the executable, the exit code for main
+    inline int RunAll() {
+        auto &registry = Registry::Get();
+        for (const auto &test: registry.cases) {
+            const int before = registry.failures;
+            test.run();
+            std::printf("%s %s\n", registry.failures == before ? "pass" : "FAIL", test.name);
+        }
+        return registry.failures == 0 ? 0 : 1;
+    }
+
+    // A decision to compare, the same poses DetectionBench uses
+    struct Pose {
+            ParkourCore::SceneLibrary::Case *sceneCase = nullptr;
+            ParkourCore::PlayerState player;
+            ParkourCore::ScaledThresholds thresholds;
+            std::string name;
+    };
+
+    // A few distances back from the obstacle and small yaw offsets per scene
+    inline std::vector<Pose> CorpusPoses(std::vector<ParkourCore::SceneLibrary::Case> &corpus) {
+        std::vector<Pose> poses;
+        for (auto &sceneCase: corpus) {
+            for (const float backOff: {0.0f, 20.0f, 40.0f}) {
+                for (const float yawOffset: {0.0f, 0.15f, -0.15f}) {
+                    Pose pose;
+                    pose.sceneCase = &sceneCase;
+                    pose.player = sceneCase.player;
+                    pose.player.position.y -= backOff;
+                    pose.player.yaw += yawOffset;
+                    pose.thresholds = ParkourCore::ScaledThresholds::ForScale(pose.player.scale);
+                    pose.name = sceneCase.name + "@" + std::to_string(static_cast<int>(backOff)) + "/" +
+                                std::to_string(static_cast<int>(yawOffset * 100.0f));
+                    poses.push_back(pose);
+                }
+            }
+        }
+        return poses;
+    }
+
+    // Same type and a ledge point within a unit
+    inline bool SameResult(const ParkourCore::DetectionResult &a, const ParkourCore::DetectionResult &b) {
+        return a.ledgeType == b.ledgeType && (a.ledgePoint - b.ledgePoint).Length() <= 1.0f;
+    }
+
+    inline std::string Describe(const ParkourCore::DetectionResult &result) {
+        return std::string(ParkourCore::ParkourType::Name(result.ledgeType)) + " at (" + std::to_string(result.ledgePoint.x) + ", " +
+               std::to_string(result.ledgePoint.y) + ", " + std::to_string(result.ledgePoint.z) + ")";
+    }
+}  // namespace Test
+
+#define TEST(name)                                                 \
+    static void name();                                            \
+    static const Test::Register name##Registration{#name, &name}; \
+    static void name()
+
+#define CHECK(condition)                                             \
+    do {                                                             \
+        if (!(condition)) {                                          \
+            Test::Fail(__FILE__, __LINE__, "CHECK(" #condition ")"); \
+        }                                                            \
+    } while (false)
+
+// what is only built when the check fails, it may be expensive
+#define CHECK_MESSAGE(condition, what)              \
+    do {                                            \
+        if (!(condition)) {                         \
+            Test::Fail(__FILE__, __LINE__, (what)); \
+        }                                           \
+    } while (false)
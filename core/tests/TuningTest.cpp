@@ -0,0 +1,127 @@
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "ParkourCore/Tuning.h"
+#include "TestUtil.h"
+
+// The shipped INI has to list every key at its compiled in value, Format has to write every key back, and a file with
+// any mistake in it must be refused whole.
+
+using namespace ParkourCore;
+
+namespace {
+    // "[Section] Key" for every key = value line, comments and blank lines skipped
+    std::set<std::string> Keys(std::string_view text) {
+        std::set<std::string> keys;
+        std::string section;
+        while (!text.empty()) {
+            const auto newline = text.find('\n');
+            std::string_view line = text.substr(0, newline);
+            text = newline == std::string_view::npos ? std::string_view{} : text.substr(newline + 1);
+            line = line.substr(0, line.find_first_of("#;"));
+            while (!line.empty() && (line.back() == ' ' || line.back() == '\r')) {
+                line.remove_suffix(1);
+            }
+            if (line.empty()) {
+                continue;
+            }
+            if (line.front() == '[') {
+                section = line;
+                continue;
+            }
+            const auto key = line.substr(0, line.find_first_of(" ="));
+            keys.insert(section + " " + std::string(key));
+        }
+        return keys;
+    }
+
+    bool Refused(std::string_view text, std::string_view expectedError) {
+        Tuning::File file;
+        std::string error;
+        const bool parsed = Tuning::Parse(text, file, error);
+        CHECK_MESSAGE(error.find(expectedError) != std::string::npos,
+                      "error \"" + error + "\", expected \"" + std::string(expectedError) + "\"");
+        return !parsed;
+    }
+}  // namespace
+
+// dist/SkyParkourNG.ini holds the defaults, so loading it changes nothing
+TEST(ShippedIniIsTheDefaults) {
+    Tuning::File shipped;
+    std::string error;
+    CHECK_MESSAGE(Tuning::LoadFile(SKYPARKOUR_DIST_INI, shipped, error), error);
+    CHECK(Tuning::Format(shipped) == Tuning::Format(Tuning::File{}));
+}
+
+// Values off the defaults parse back from Format bit for bit
+TEST(FormatRoundTrips) {
+    std::string error;
+    Tuning::File changed;
+    changed.hotReload = true;
+    changed.thresholds.ledgeForwardStep = 7.25f;
+    changed.thresholds.headingDistanceWeight = 0.0051f;
+    changed.thresholds.vaultDownIterations = 12;
+
+    const auto text = Tuning::Format(changed);
+    Tuning::File parsed;
+    CHECK_MESSAGE(Tuning::Parse(text, parsed, error), error);
+    CHECK(Tuning::Format(parsed) == text);
+    CHECK(parsed.hotReload && parsed.thresholds.ledgeForwardStep == 7.25f && parsed.thresholds.headingDistanceWeight == 0.0051f &&
+          parsed.thresholds.vaultDownIterations == 12);
+}
+
+// Format writes every key the shipped file lists and nothing else
+TEST(FormatWritesEveryShippedKey) {
+    std::ifstream input(SKYPARKOUR_DIST_INI, std::ios::binary);
+    const std::string shipped((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    CHECK(!shipped.empty());
+
+    const auto shippedKeys = Keys(shipped);
+    const auto formattedKeys = Keys(Tuning::Format(Tuning::File{}));
+    for (const auto &key: shippedKeys) {
+        CHECK_MESSAGE(formattedKeys.contains(key), "Format misses " + key);
+    }
+    for (const auto &key: formattedKeys) {
+        CHECK_MESSAGE(shippedKeys.contains(key), "dist/SkyParkourNG.ini misses " + key);
+    }
+}
+
+TEST(UnknownKeyIsRefused) {
+    CHECK(Refused("[Ledge]\nForwardStepp = 8\n", "line 2: unknown key [Ledge] ForwardStepp"));
+    CHECK(Refused("[Ledgee]\nForwardStep = 8\n", "unknown key"));
+    CHECK(Refused("ForwardStep = 8\n", "unknown key"));  // Outside any section
+}
+
+TEST(BadNumberIsRefused) {
+    CHECK(Refused("[Ledge]\nForwardStep = eight\n", "bad value for ForwardStep"));
+    CHECK(Refused("[Ledge]\nForwardStep = 8u\n", "bad value"));
+    CHECK(Refused("[Ledge]\nForwardStep = nan\n", "bad value"));
+    CHECK(Refused("[Ledge]\nForwardIterations = 10.5\n", "ForwardIterations must be"));
+    CHECK(Refused("[General]\nHotReload = yes\n", "HotReload must be 0 or 1"));
+    CHECK(Refused("[Ledge]\nForwardStep\n", "expected key = value"));
+    CHECK(Refused("[Ledge\nForwardStep = 8\n", "unterminated section"));
+}
+
+TEST(OutOfRangeIsRefused) {
+    CHECK(Refused("[Ledge]\nForwardStep = -1\n", "bad value for ForwardStep"));
+    CHECK(Refused("[Ledge]\nForwardIterations = 0\n", "ForwardIterations must be 1..64"));
+    CHECK(Refused("[Ledge]\nForwardIterations = 65\n", "ForwardIterations must be 1..64"));
+    CHECK(Refused("[Quality]\nTier = 9\n", "Tier must be"));
+    CHECK(Refused("[General]\nHotReload = 2\n", "HotReload must be 0 or 1"));
+}
+
+// One bad line anywhere keeps every earlier line from applying
+TEST(RefusedFileChangesNothing) {
+    Tuning::File file;
+    file.thresholds.ledgeForwardStep = 3.0f;
+    std::string error;
+    CHECK(!Tuning::Parse("[Ledge]\nForwardStep = 9\nForwardIterations = 0\n", file, error));
+    CHECK(file.thresholds.ledgeForwardStep == 3.0f);
+}
+
+int main() {
+    return Test::RunAll();
+}
@@ -0,0 +1,57 @@
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "ParkourCore/LedgeIndexBaker.h"
+
+// Bakes a scene file (see CollisionScene.h) into a ledge index file LedgeIndex::LoadFile maps.
+//
+//   SkyParkourBakeLedgeIndex scene.txt out.spli [--cell 0001A26F] [--grid 256] [--spacing 16]
+
+using namespace ParkourCore;
+
+namespace {
+    std::string_view Option(int argc, char **argv, std::string_view key, std::string_view fallback) {
+        for (int i = 3; i + 1 < argc; i++) {
+            if (key == argv[i]) {
+                return argv[i + 1];
+            }
+        }
+        return fallback;
+    }
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s scene.txt out.spli [--cell hex] [--grid units] [--spacing units]\n", argv[0]);
+        return 1;
+    }
+
+    CollisionScene scene;
+    std::string error;
+    if (!scene.LoadFile(argv[1], error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    LedgeBakeSettings settings;
+    settings.cellKey = static_cast<std::uint32_t>(std::stoul(std::string(Option(argc, argv, "--cell", "0")), nullptr, 16));
+    settings.gridSize = std::stof(std::string(Option(argc, argv, "--grid", "256")));
+    settings.sampleSpacing = std::stof(std::string(Option(argc, argv, "--spacing", "16")));
+    if (!(settings.gridSize > 0.0f) || !(settings.sampleSpacing > 0.0f)) {
+        std::fprintf(stderr, "--grid and --spacing must be positive\n");
+        return 1;
+    }
+
+    LedgeBakeStats stats;
+    const auto bytes = BakeLedgeIndex(scene, settings, &stats);
+    if (bytes.empty() || !WriteLedgeIndex(argv[2], bytes)) {
+        std::fprintf(stderr, "can't write %s\n", argv[2]);
+        return 1;
+    }
+
+    std::printf("%llu ledges from %llu open edges (%llu walkable of %llu baked triangles), %zu bytes\n",
+                static_cast<unsigned long long>(stats.ledges), static_cast<unsigned long long>(stats.openEdges),
+                static_cast<unsigned long long>(stats.walkable), static_cast<unsigned long long>(stats.triangles), bytes.size());
+    return 0;
+}
@@ -6,26 +6,26 @@
             static inline REL::Relocation<Fn_t> _ProcessEvent;  // 01
             inline RE::BSEventNotifyControl Hook(const RE::BSAnimationGraphEvent* a_event,
                                                  RE::BSTEventSource<RE::BSAnimationGraphEvent>* a_eventSource) {
-                if (ModSettings::ModEnabled) {
-                    if (a_event) {
-                        auto actor = a_event->holder;
-                        if (actor && actor->IsPlayerRef()) {
-                            //logger::info(">> AnimEvent: {}", a_event->tag.c_str());
+                // Every actor's events come through here, read the settings only for a player action that is ending
+                if (a_event) {
+                    auto actor = a_event->holder;
+                    if (actor && actor->IsPlayerRef() && RuntimeVariables::ParkourEndQueued) {
+                        //logger::info(">> AnimEvent: {}", a_event->tag.c_str());
 
-                            if (RuntimeVariables::ParkourEndQueued) {
-                                if (RE::PlayerCharacter::GetSingleton()->IsInRagdollState()) {
-                                    ParkourUtility::ToggleControlsForParkour(true);
-                                    RuntimeVariables::ParkourEndQueued = false;
-                                }
-                                // Reenable controls
-                                else if (a_event->tag == "idleChairGetUp") {
-                                    // Swap the leg for step animation
-                                    RuntimeMethods::SwapLegs();
+                        const auto settings = ModSettings::Get();
+                        if (settings.ModEnabled) {
+                            if (RE::PlayerCharacter::GetSingleton()->IsInRagdollState()) {
+                                ParkourUtility::ToggleControlsForParkour(true);
+                                RuntimeVariables::ParkourEndQueued = false;
+                            }
+                            // Reenable controls
+                            else if (a_event->tag == "idleChairGetUp") {
+                                // Swap the leg for step animation
+                                RuntimeMethods::SwapLegs();
 
-                                    ParkourUtility::ToggleControlsForParkour(true);
-                                    Parkouring::UpdateParkourPoint();
-                                    RuntimeVariables::ParkourEndQueued = false;
-                                }
+                                ParkourUtility::ToggleControlsForParkour(true);
+                                Parkouring::UpdateParkourPoint(settings);
+                                RuntimeVariables::ParkourEndQueued = false;
                             }
                         }
                     }
@@ -101,9 +101,10 @@ bool Hooks::NotifyGraphHandler::OnPlayerCharacter(RE::IAnimationGraphManagerHold
 
             if (a_eventName == "IdleLeverPushStart") {
                 if (result) {
-                    Parkouring::AdjustPlayerPosition(RuntimeVariables::selectedLedgeType);
+                    const auto &active = RuntimeVariables::activeParkour;
+                    Parkouring::AdjustPlayerPosition(active);
                     Parkouring::PostParkourStaminaDamage(RE::PlayerCharacter::GetSingleton(),
-                                                         ParkourUtility::CheckIsVaultActionFromType(RuntimeVariables::selectedLedgeType));
+                                                         ParkourUtility::CheckIsVaultActionFromType(active.ledgeType));
                 }
                 else {
                     // Notify failed, unlock controls again
@@ -4,13 +4,11 @@
 
 namespace ButtonStates {
 
-    extern int32_t DXCODE;
-
     extern std::unordered_map<int32_t, int32_t> xinputToCKMap;
 
     extern int32_t MapToCKIfPossible(int32_t dxcode);
 
-    extern void RegisterActivation(RE::InputEvent* event);
+    extern void RegisterActivation(RE::InputEvent* event, const ModSettings::Settings& settings);
 }  // namespace ButtonStates
 
 class ButtonEventListener : public RE::BSTEventSink<RE::InputEvent*> {
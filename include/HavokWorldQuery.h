@@ -0,0 +1,23 @@
+#pragma once
+#include "References.h"
+#include "ParkourCore/RayBatch.h"
+
+// bhkWorld::PickObject backend. Player, cell, bhkWorld, world scale and the player's collision filter
+// are resolved once on construction, so one instance serves every ray of a detection pass.
+// SweepBox keeps the WorldQuery corner ray sampling, bhkWorld has no shape cast this plugin can reach.
+class HavokWorldQuery : public ParkourCore::WorldQuery {
+    public:
+        explicit HavokWorldQuery(RE::PlayerCharacter *player, RE::COL_LAYER layerMask = RE::COL_LAYER::kLOS);
+
+        bool IsValid() const {
+            return bhkWorld != nullptr;
+        }
+
+        void CastBatch(ParkourCore::RayBatch &batch) override;
+        ParkourCore::RayHit CastRay(const ParkourCore::Vec3 &origin, const ParkourCore::Vec3 &dir, float maxDist) override;
+
+    private:
+        RE::bhkWorld *bhkWorld = nullptr;
+        float havokWorldScale = 0.0f;
+        uint32_t filterInfo = 0;
+};
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "References.h"
+#include "Scheduler.h"
 
 // Taken from Skyrim Souls RE -> https://github.com/Vermunds/SkyrimSoulsRE.git
 namespace Hooks {
@@ -33,9 +34,10 @@ namespace Hooks {
 
     template <class T>
     inline bool InputHandlerEx<T>::CanProcess_Jump(RE::InputEvent* a_event) {
-        if (ModSettings::ModEnabled) {
-            if (ModSettings::UsePresetParkourKey && ModSettings::PresetParkourKey == ModSettings::ParkourKeyOptions::kJump &&
-                ModSettings::parkourDelay == 0 && RuntimeVariables::selectedLedgeType != ParkourType::NoLedge) {
+        const auto settings = ModSettings::Get();
+        if (settings.ModEnabled) {
+            if (settings.UsePresetParkourKey && settings.PresetParkourKey == ModSettings::ParkourKeyOptions::kJump &&
+                settings.parkourDelay == 0 && RuntimeVariables::detection.Load().result.ledgeType != ParkourType::NoLedge) {
                 //logger::info("Prevented Jump");
 
                 return false;
@@ -51,10 +53,11 @@ namespace Hooks {
 
     template <class T>
     void InputHandlerEx<T>::ProcessButton_Jump(RE::ButtonEvent* a_event, RE::PlayerControlsData* a_data) {
-        if (ModSettings::ModEnabled && !ParkourUtility::IsOnMount()) {
-            if (ModSettings::UsePresetParkourKey && ModSettings::PresetParkourKey == ModSettings::ParkourKeyOptions::kJump) {
+        const auto settings = ModSettings::Get();
+        if (settings.ModEnabled && !ParkourUtility::IsOnMount()) {
+            if (settings.UsePresetParkourKey && settings.PresetParkourKey == ModSettings::ParkourKeyOptions::kJump) {
                 auto btn = a_event->AsButtonEvent();
-                if (btn && btn->QUserEvent() == "Jump" && ModSettings::parkourDelay != 0.0f) {
+                if (btn && btn->QUserEvent() == "Jump" && settings.parkourDelay != 0.0f) {
                     if (btn->IsDown()) {
                         return;
                     }
@@ -65,23 +68,22 @@ namespace Hooks {
 
                         // create a delayed Down
                         RE::ButtonEvent* downEvt =
-                            (held < ModSettings::parkourDelay) ? RE::ButtonEvent::Create(dev, "Jump", id, 1.0f, 0.0f) : nullptr;
+                            (held < settings.parkourDelay) ? RE::ButtonEvent::Create(dev, "Jump", id, 1.0f, 0.0f) : nullptr;
                         // for a tap, also create a delayed Up
                         RE::ButtonEvent* upEvt = downEvt ? RE::ButtonEvent::Create(dev, "Jump", id, 0, held) : nullptr;
 
                         if (downEvt || upEvt) {
-                            std::jthread([this, downEvt, upEvt, a_data]() {
-                                SKSE::GetTaskInterface()->AddTask([this, downEvt, upEvt, a_data]() {
-                                    if (downEvt) {
-                                        _ProcessButtonJump(this, downEvt, a_data);
-                                        delete downEvt;
-                                    }
-                                    if (upEvt) {
-                                        _ProcessButtonJump(this, upEvt, a_data);
-                                        delete upEvt;
-                                    }
-                                });
-                            }).detach();
+                            // Replay on the next frame, after the engine is done with the original Up
+                            Scheduler::AfterFrames(1, [this, downEvt, upEvt, a_data]() {
+                                if (downEvt) {
+                                    _ProcessButtonJump(this, downEvt, a_data);
+                                    delete downEvt;
+                                }
+                                if (upEvt) {
+                                    _ProcessButtonJump(this, upEvt, a_data);
+                                    delete upEvt;
+                                }
+                            });
                             return;  // don’t let the engine see the original Up
                         }
                     }
@@ -94,7 +96,7 @@ namespace Hooks {
 
     template <class T>
     inline bool InputHandlerEx<T>::CanProcess_Sneak(RE::InputEvent* a_event) {
-        if (ModSettings::ModEnabled) {
+        if (ModSettings::Get().ModEnabled) {
             if (RuntimeVariables::ParkourEndQueued) {
                 return false;
             }
@@ -2,6 +2,7 @@
 
 #include "References.h"
 #include "Parkouring.h"
+#include "ParkourCore/MenuTracker.h"
 
 struct MenuListener : public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
     public:
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "ParkourCore/Tuning.h"
+
+// Detection tuning from Data/SKSE/Plugins/SkyParkourNG.ini, compiled in values when the file is missing or invalid
+namespace ParkourTuning {
+    // Call once at data loaded. Starts polling the file when it says HotReload = 1.
+    void Load();
+
+    // Unscaled, one pointer load
+    const ParkourCore::ScaledThresholds &Current();
+
+    // Changes on every successful (re)load
+    std::uint32_t Version();
+}  // namespace ParkourTuning
@@ -1,30 +1,42 @@
 #pragma once
 #include "References.h"
 #include "ScaleUtility.h"
+#include "ParkourCore/PlayerState.h"
 
 namespace ParkourUtility {
 
     bool ToggleControlsForParkour(bool enable);
-    RE::NiPoint3 GetPlayerDirFlat(RE::Actor *player);
-    void LastObjectHitType(RE::COL_LAYER obj);
-    float RayCast(RE::NiPoint3 rayStart, RE::NiPoint3 rayDir, float maxDist, RE::hkVector4 &normalOut, RE::COL_LAYER layerMask);
+    ParkourCore::PlayerState CapturePlayerState(RE::PlayerCharacter *player, const ModSettings::Settings &settings);
     bool IsPlayerUsingFurniture(RE::PlayerCharacter *);
     bool IsPlayerInCharGen(RE::PlayerCharacter *);
     bool IsBeastForm();
     bool IsOnMount();
     bool IsPlayerInSyncedAnimation(RE::PlayerCharacter *);
-    float CalculateParkourStamina();
-    bool PlayerHasEnoughStamina();
+    float CalculateParkourStamina(const ModSettings::Settings &settings);
+    bool PlayerHasEnoughStamina(const ModSettings::Settings &settings);
     bool DamageActorStamina(RE::Actor *actor, float amount);
-    bool ShouldReplaceMarkerWithFailed();
+    bool ShouldReplaceMarkerWithFailed(const ModSettings::Settings &settings);
     bool CheckIsVaultActionFromType(int32_t selectedLedgeType);
     bool PlayerIsGroundedOrSliding();
     bool PlayerIsMidairAndNotSliding();
     bool PlayerIsSwimming();
     bool PlayerWantsToDrawSheath();
-    bool IsParkourActive();
+    bool IsParkourActive(int ledgeType);
     bool PlayerIsOnStairs();
     float magnitudeXY(float x, float y);
+
+    // Monotonic milliseconds, the clock for timers and cache expiry
+    inline std::uint64_t SteadyNowMs() {
+        using namespace std::chrono;
+        return static_cast<std::uint64_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    inline ParkourCore::Vec3 ToVec3(const RE::NiPoint3 &p) {
+        return {p.x, p.y, p.z};
+    }
+    inline RE::NiPoint3 ToNiPoint3(const ParkourCore::Vec3 &v) {
+        return {v.x, v.y, v.z};
+    }
     //void MoveMarkerToLedge(RE::TESObjectREFR *ledgeMarker, RE::NiPoint3 ledgePoint, RE::NiPoint3 backwardAdjustment, float zAdjust);
     //void RotateLedgeMarker(RE::TESObjectREFR *ledgeMarker, RE::NiPoint3 playerDirFlat);
 }  // namespace ParkourUtility
\ No newline at end of file
@@ -4,19 +4,32 @@
 #include "ButtonListener.h"
 #include "MenuListener.h"
 #include "ScaleUtility.h"
+#include "HavokWorldQuery.h"
+#include "Scheduler.h"
+#include "ParkourTuning.h"
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/DetectionCache.h"
+#include "ParkourCore/DetectionJob.h"
+#include "ParkourCore/ScaledThresholds.h"
+#include "ParkourCore/FrameCoalescer.h"
+#include "ParkourCore/GrabPrediction.h"
+#include "ParkourCore/HeadingScan.h"
+#include "ParkourCore/QualityTier.h"
 
 namespace Parkouring {
-    int LedgeCheck(RE::NiPoint3 &ledgePoint, RE::NiPoint3 checkDir, float minLedgeHeight, float maxLedgeHeight);
-    int VaultCheck(RE::NiPoint3 &ledgePoint, RE::NiPoint3 checkDir, float vaultLength, float maxElevationIncrease, float minVaultHeight,
-                   float maxVaultHeight);
-    bool PlaceAndShowIndicator();
-    int GetLedgePoint(float backwardOffset);
+    // A decision reads the settings once and passes that copy down, MCM can republish in between
+    bool PlaceAndShowIndicator(const ParkourCore::DetectionResult &detection, const ModSettings::Settings &settings);
+    // Null while a time sliced decision is still running
+    std::optional<RuntimeVariables::Detection> GetLedgePoint(const ModSettings::Settings &settings);
     void InterpolateRefToPosition(RE::TESObjectREFR *obj, RE::NiPoint3 position, float speed, int timeoutMS);
-    void AdjustPlayerPosition(int ledgeType);
+    void AdjustPlayerPosition(const ParkourCore::DetectionResult &detection);
 
-    bool TryActivateParkour();
-    void UpdateParkourPoint();
-    void ParkourReadyRun(int ledge);
+    bool TryActivateParkour(const ModSettings::Settings &settings);
+    void UpdateParkourPoint(const ModSettings::Settings &settings);
+    void RequestParkourPointUpdate();
+    void LogParkourPointUpdateStats();
+    void SampleFrameTime();
+    void ParkourReadyRun(const ParkourCore::DetectionResult &detection);
     void PostParkourStaminaDamage(RE::PlayerCharacter *player, bool isVault);
 
     void SetParkourOnOff(bool turnOn);
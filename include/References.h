@@ -1,16 +1,39 @@
 #pragma once
 
+#include "ParkourCore/ParkourTypes.h"
+#include "ParkourCore/Detection.h"
+#include "ParkourCore/Published.h"
+#include "ParkourCore/SeqLock.h"
+
 namespace ModSettings {
-    extern bool UsePresetParkourKey;
-    extern int PresetParkourKey;
     const enum ParkourKeyOptions { kJump = 0, kSprint, kActivate, k_Custom };  // k_Custom is unused for now
-    extern bool ModEnabled;
-    extern bool UseIndicators;
-    extern float parkourDelay;
-    extern bool Enable_Stamina_Consumption;
-    extern bool Is_Stamina_Required;
-    extern float Stamina_Damage;
-    extern bool Smart_Parkour_Enabled;
+
+    // Everything MCM can change. Papyrus publishes a new copy, hooks take one copy per decision so a
+    // half applied MCM page is never seen.
+    struct Settings {
+            bool UsePresetParkourKey = true;
+            int PresetParkourKey = kJump;
+            int32_t CustomParkourKey = 0;  // DX scan code, used when the preset key is off
+            bool ModEnabled = true;
+            bool UseIndicators = true;
+            float parkourDelay = 0.0f;
+            bool Enable_Stamina_Consumption = true;
+            bool Is_Stamina_Required = true;
+            float Stamina_Damage = 20.0f;
+            bool Smart_Parkour_Enabled = true;  // Don't use high/failed ledge when moving, don't use vault when standing still
+    };
+
+    extern ParkourCore::Published<Settings> published;
+
+    inline Settings Get() {
+        return published.Load();
+    }
+
+    // Copies the current settings, applies change and publishes the result
+    template <class F>
+    Settings Update(F &&change) {
+        return published.Update(std::forward<F>(change));
+    }
 }  // namespace ModSettings
 
 namespace RuntimeMethods {
@@ -25,73 +48,25 @@ namespace Compatibility {
     //extern bool ImprovedCamera;
 }  // namespace Compatibility
 
-namespace HardCodedVariables {
-    extern const float climbMaxHeight;
-    extern const float climbMinHeight;
-
-    extern const float vaultMaxHeight;
-    extern const float vaultMinHeight;
-
-    // 220
-    extern const float highestLedgeLimit;
-    // 170
-    extern const float highLedgeLimit;
-    // 123
-    extern const float medLedgeLimit;
-    // 80
-    extern const float lowLedgeLimit;
-    // 40
-    extern const float highStepLimit;
-
-    // 250
-    extern const float highestLedgeElevation;
-    // 200
-    extern const float highLedgeElevation;
-    // 153
-    extern const float medLedgeElevation;
-    // 110
-    extern const float lowLedgeElevation;
-    // 70
-    extern const float stepHighElevation;
-    // 50
-    extern const float stepLowElevation;
-    // 60
-    extern const float vaultElevation;  // This is exception, vault needs to put player further below. Elevation is 20, plus 40 adjustment
-    // 60
-    extern const float grabElevation;
-}  // namespace HardCodedVariables
-
-namespace ParkourType {
-    // 8
-    extern const int Highest;
-    // 7
-    extern const int High;
-    // 6
-    extern const int Medium;
-    // 5
-    extern const int Low;
-    // 4
-    extern int const StepHigh;
-    // 3
-    extern int const StepLow;
-    // 2
-    extern int const Vault;
-    // 1
-    extern int const Grab;
-    // 0
-    extern int const Failed;
-    // -1
-    extern const int NoLedge;
-}  // namespace ParkourType
+// Thresholds and parkour types live in the engine independent core
+namespace HardCodedVariables = ParkourCore::HardCodedVariables;
+namespace ParkourType = ParkourCore::ParkourType;
 
 namespace RuntimeVariables {
     extern bool IsParkourActive;
-    extern RE::COL_LAYER lastHitObject;
     extern float PlayerScale;
-    extern int selectedLedgeType;
-    extern RE::NiPoint3 ledgePoint;
-    extern RE::NiPoint3 playerDirFlat;
-    extern RE::NiPoint3 backwardAdjustment;
+
+    // Latest detection pass. UpdateParkourPoint stores it whole, readers copy it whole, so a ledge type is never
+    // paired with a point from another pass. The seqlock generation numbers the passes.
+    struct Detection {
+            ParkourCore::DetectionResult result;
+            std::uint64_t detectedAtMs = 0;
+            std::uint32_t framesSpanned = 1;  // Updates the decision took, more than one when time sliced
+    };
+    extern ParkourCore::SeqLock<Detection> detection;
+
+    // Locked in by activation for the running action, main thread only
+    extern ParkourCore::DetectionResult activeParkour;
 
     extern bool wasFirstPerson;
 
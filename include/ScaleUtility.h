@@ -7,5 +7,10 @@ namespace ScaleUtility {
 
     [[nodiscard]] float GetNodeScale(const RE::Actor* a_actor, const std::string_view a_boneName);
 
+    // The player's model and scale bones are resolved when the 3D is reloaded or after InvalidateScale, their current
+    // scales are multiplied on every call
     [[nodiscard]] float GetScale();
+
+    // The bones may have been replaced without a 3D reload (RaceMenu, race switch)
+    void InvalidateScale();
 }  // namespace ScaleUtility
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ParkourCore/TimerWheel.h"
+
+// Delayed callbacks on the main thread. The wheel advances once per frame from a Main::Update hook and runs what is
+// due right there, a frame timer fires on the first frame boundary after the one it was scheduled in.
+namespace Scheduler {
+    using Handle = ParkourCore::TimerWheel::Handle;
+    using Callback = ParkourCore::TimerWheel::Callback;
+    using FrameCallback = void (*)();
+
+    // Hooks Main::Update, before that nothing fires
+    void Install();
+
+    Handle AfterMs(std::uint32_t delayMs, Callback callback);
+    Handle AfterFrames(std::uint32_t frames, Callback callback);
+    bool Cancel(Handle handle);
+
+    // Runs callback on every frame from now on, after the timers due that frame
+    void EveryFrame(FrameCallback callback);
+}  // namespace Scheduler
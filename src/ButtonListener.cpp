@@ -1,8 +1,6 @@
 ﻿#include "ButtonListener.h"
 #include "InputHandler.hpp"
 
-int32_t ButtonStates::DXCODE = 0;
-
 std::unordered_map<int32_t, int32_t> ButtonStates::xinputToCKMap = {
     // Mouse
     {2, 258},  // Mouse middle
@@ -42,13 +40,13 @@ int32_t ButtonStates::MapToCKIfPossible(int32_t dxcode) {
     }
     return dxcode;  // Return default value if key not found
 }
-void ButtonStates::RegisterActivation(RE::InputEvent* event) {
+void ButtonStates::RegisterActivation(RE::InputEvent* event, const ModSettings::Settings& settings) {
     const auto buttonEvent = event->AsButtonEvent();
 
     // Delay Threshold Passed
     if (buttonEvent->IsDown() || buttonEvent->IsHeld()) {
-        if (ModSettings::parkourDelay <= buttonEvent->heldDownSecs) {
-            Parkouring::TryActivateParkour();
+        if (settings.parkourDelay <= buttonEvent->heldDownSecs) {
+            Parkouring::TryActivateParkour(settings);
         }
     }
 }
@@ -74,9 +72,12 @@ RE::BSEventNotifyControl ButtonEventListener::ProcessEvent(RE::InputEvent* const
     if (!a_event)
         return RE::BSEventNotifyControl::kContinue;
 
-    // Update this here,
-    if (ModSettings::ModEnabled) {
-        _THREAD_POOL.enqueue([] { SKSE::GetTaskInterface()->AddTask([] { Parkouring::UpdateParkourPoint(); }); });
+    // One settings snapshot for the whole event batch
+    const auto settings = ModSettings::Get();
+
+    // Update this here, coalesced to one detection pass per frame
+    if (settings.ModEnabled) {
+        Parkouring::RequestParkourPointUpdate();
     }
 
     for (auto event = *a_event; event; event = event->next) {
@@ -92,43 +93,43 @@ RE::BSEventNotifyControl ButtonEventListener::ProcessEvent(RE::InputEvent* const
                 dxScanCode = ButtonStates::xinputToCKMap[dxScanCode];
             }
 
-            if (ModSettings::UsePresetParkourKey) {
+            if (settings.UsePresetParkourKey) {
                 auto userEventName = event->QUserEvent();
-                //logger::info("PresetParkourKey {}\n ButtonEvent ID {}", ModSettings::PresetParkourKey, buttonId);
+                //logger::info("PresetParkourKey {}\n ButtonEvent ID {}", settings.PresetParkourKey, buttonId);
                 //logger::info("JumpMap {}\n SprintMap {}\nActivateMap {}", jumpMapping,sprintMapping,activateMapping);
 
-                if (ModSettings::PresetParkourKey == ModSettings::ParkourKeyOptions::kJump &&
+                if (settings.PresetParkourKey == ModSettings::ParkourKeyOptions::kJump &&
                     userEventName == RE::UserEvents::GetSingleton()->jump) {
                     if (RuntimeVariables::ParkourEndQueued) {
                         continue;
                     }
 
-                    ButtonStates::RegisterActivation(event);
+                    ButtonStates::RegisterActivation(event, settings);
                 }
-                else if (ModSettings::PresetParkourKey == ModSettings::ParkourKeyOptions::kSprint &&
+                else if (settings.PresetParkourKey == ModSettings::ParkourKeyOptions::kSprint &&
                          userEventName == RE::UserEvents::GetSingleton()->sprint) {
                     if (RuntimeVariables::ParkourEndQueued) {
                         continue;
                     }
 
-                    ButtonStates::RegisterActivation(event);
+                    ButtonStates::RegisterActivation(event, settings);
                 }
-                else if (ModSettings::PresetParkourKey == ModSettings::ParkourKeyOptions::kActivate &&
+                else if (settings.PresetParkourKey == ModSettings::ParkourKeyOptions::kActivate &&
                          userEventName == RE::UserEvents::GetSingleton()->activate) {
                     if (RuntimeVariables::ParkourEndQueued) {
                         continue;
                     }
 
-                    ButtonStates::RegisterActivation(event);
+                    ButtonStates::RegisterActivation(event, settings);
                 }
             }
             else {
-                if (dxScanCode == ButtonStates::DXCODE) {
+                if (dxScanCode == settings.CustomParkourKey) {
                     if (RuntimeVariables::ParkourEndQueued) {
                         continue;
                     }
 
-                    ButtonStates::RegisterActivation(event);
+                    ButtonStates::RegisterActivation(event, settings);
                 }
             }
         }
@@ -0,0 +1,60 @@
+#include "HavokWorldQuery.h"
+
+static_assert(static_cast<uint32_t>(ParkourCore::CollisionLayer::kLOS) == static_cast<uint32_t>(RE::COL_LAYER::kLOS));
+static_assert(static_cast<uint32_t>(ParkourCore::CollisionLayer::kDebrisLarge) == static_cast<uint32_t>(RE::COL_LAYER::kDebrisLarge));
+static_assert(sizeof(ParkourCore::Vec3) == sizeof(RE::NiPoint3));
+
+HavokWorldQuery::HavokWorldQuery(RE::PlayerCharacter *player, RE::COL_LAYER layerMask) {
+    if (!player) {
+        return;
+    }
+    const auto cell = player->GetParentCell();
+    if (!cell) {
+        return;
+    }
+    bhkWorld = cell->GetbhkWorld();
+    if (!bhkWorld) {
+        return;
+    }
+
+    havokWorldScale = RE::bhkWorld::GetWorldScale();
+
+    // Set the collision filter info to exclude the player
+    uint32_t collisionFilterInfo = 0;
+    player->GetCollisionFilterInfo(collisionFilterInfo);
+    filterInfo = (collisionFilterInfo & 0xFFFF0000) | static_cast<uint32_t>(layerMask);
+}
+
+ParkourCore::RayHit HavokWorldQuery::CastRay(const ParkourCore::Vec3 &origin, const ParkourCore::Vec3 &dir, float maxDist) {
+    if (!bhkWorld) {
+        return ParkourCore::MakeMiss(maxDist);  // Return maxDist if Havok world is unavailable
+    }
+
+    const RE::NiPoint3 rayStart{origin.x, origin.y, origin.z};
+    const RE::NiPoint3 rayDir{dir.x, dir.y, dir.z};
+
+    RE::bhkPickData pickData;
+
+    // Set ray start and end points (scaled to Havok world)
+    pickData.rayInput.from = rayStart * havokWorldScale;
+    pickData.rayInput.to = (rayStart + rayDir * maxDist) * havokWorldScale;
+    pickData.rayInput.filterInfo = filterInfo;
+
+    // Perform the raycast
+    if (bhkWorld->PickObject(pickData) && pickData.rayOutput.HasHit()) {
+        const auto &n = pickData.rayOutput.normal.quad.m128_f32;
+        const uint32_t layerIndex = pickData.rayOutput.rootCollidable->broadPhaseHandle.collisionFilterInfo & 0x7F;
+
+        return ParkourCore::MakeHit(maxDist, pickData.rayOutput.hitFraction, {n[0], n[1], n[2]},
+                                    static_cast<ParkourCore::CollisionLayer>(layerIndex));
+    }
+
+    // No hit
+    return ParkourCore::MakeMiss(maxDist);
+}
+
+void HavokWorldQuery::CastBatch(ParkourCore::RayBatch &batch) {
+    for (std::size_t i = 0; i < batch.Size(); i++) {
+        batch.results[i] = CastRay(batch.Origin(i), batch.Dir(i), batch.MaxDist(i));
+    }
+}
@@ -15,29 +15,44 @@ namespace Menus {
                                               RE::Console::MENU_NAME,          RE::TweenMenu::MENU_NAME,
                                               RE::MainMenu::MENU_NAME};
 
-    bool CheckMenuOpen() {
-        auto ui = RE::UI::GetSingleton();
-        // Check if any of the excluded menus are open
-        for (const std::string_view menuName: Menus::excludedMenus) {
-            if (ui->IsMenuOpen(menuName)) {
-                return true;
+    // Interned copies of the names above, kept alive so the pooled pointers stay valid
+    std::vector<RE::BSFixedString> internedMenus;
+    ParkourCore::MenuTracker openMenus;
+    int mainMenuIndex = -1;
+
+    void InternMenus() {
+        if (!internedMenus.empty()) {
+            return;
+        }
+        internedMenus.reserve(std::size(excludedMenus));
+        for (const std::string_view menuName: excludedMenus) {
+            const auto &interned = internedMenus.emplace_back(menuName);
+            const int index = openMenus.Track(interned.data());
+            if (menuName == RE::MainMenu::MENU_NAME) {
+                mainMenuIndex = index;
             }
         }
-        return false;
-    }
 
-    bool MainMenuShowing() {
+        // Menus that opened before the sink was registered
         auto ui = RE::UI::GetSingleton();
-        if (ui->IsMenuOpen(RE::MainMenu::MENU_NAME)) {
-            return true;
+        for (const auto &menuName: internedMenus) {
+            openMenus.SetOpen(menuName.data(), ui->IsMenuOpen(menuName.c_str()));
         }
-        return false;
+    }
+
+    bool CheckMenuOpen() {
+        return openMenus.AnyOpen();
+    }
+
+    bool MainMenuShowing() {
+        return openMenus.IsOpen(mainMenuIndex);
     }
 }  // namespace Menus
 
 bool MenuListener::Register() {
     auto listener = MenuListener::GetSingleton();
     if (listener) {
+        Menus::InternMenus();
         RE::UI::GetSingleton()->AddEventSink<RE::MenuOpenCloseEvent>(listener);  // :contentReference[oaicite:0]{index=0}
         return true;
     }
@@ -53,6 +68,9 @@ bool MenuListener::Unregister() {
 }
 
 RE::BSEventNotifyControl MenuListener::ProcessEvent(const RE::MenuOpenCloseEvent* ev, RE::BSTEventSource<RE::MenuOpenCloseEvent>*) {
+    // Same pooled string as the interned name, untracked menus are ignored
+    Menus::openMenus.SetOpen(ev->menuName.data(), ev->opening);
+
     if (ev->opening) {
         //logger::info("Menu {} opened", ev->menuName.c_str());
 
@@ -81,6 +99,7 @@ RE::BSEventNotifyControl MenuListener::ProcessEvent(const RE::MenuOpenCloseEvent
 
         // Racemenu closed, reset some stuff
         if (ev->menuName == RE::RaceSexMenu::MENU_NAME) {
+            ScaleUtility::InvalidateScale();
             Parkouring::SetParkourOnOff(true);
         }
 
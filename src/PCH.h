@@ -156,9 +156,6 @@
 
 //local
 #include "Util.h"
-#include "ThreadPool.hpp"
-static ThreadPool SKYPARKOUR_THREAD_POOL;
-#define _THREAD_POOL SKYPARKOUR_THREAD_POOL
 
 
 #undef cdecl  // Workaround for Clang 14 CMake configure error.
@@ -0,0 +1,54 @@
+#include "ParkourTuning.h"
+#include "Scheduler.h"
+
+namespace {
+    constexpr std::string_view tuningPath = "Data/SKSE/Plugins/SkyParkourNG.ini";
+    constexpr std::uint32_t pollIntervalMs = 1000;
+
+    ParkourCore::Tuning::Store store;
+    std::filesystem::file_time_type lastWriteTime;
+
+    bool ReadFile() {
+        std::error_code ec;
+        lastWriteTime = std::filesystem::last_write_time(tuningPath, ec);
+
+        ParkourCore::Tuning::File file;
+        std::string error;
+        if (!ParkourCore::Tuning::LoadFile(tuningPath, file, error)) {
+            logger::warn("Tuning: {}, keeping previous values", error);
+            return false;
+        }
+        store.Publish(file.thresholds);
+        logger::info("Tuning: loaded {} (version {})", tuningPath, store.Version());
+        return file.hotReload;
+    }
+
+    // Re-arms itself, only ever scheduled when the file asked for hot reload
+    void Poll() {
+        std::error_code ec;
+        const auto writeTime = std::filesystem::last_write_time(tuningPath, ec);
+        if (!ec && writeTime != lastWriteTime) {
+            ReadFile();
+        }
+        Scheduler::AfterMs(pollIntervalMs, [] { Poll(); });
+    }
+}  // namespace
+
+void ParkourTuning::Load() {
+    if (!std::filesystem::exists(tuningPath)) {
+        logger::info("Tuning: {} not found, using built in values", tuningPath);
+        return;
+    }
+    if (ReadFile()) {
+        logger::info("Tuning: hot reload on, polling every {} ms", pollIntervalMs);
+        Scheduler::AfterMs(pollIntervalMs, [] { Poll(); });
+    }
+}
+
+const ParkourCore::ScaledThresholds &ParkourTuning::Current() {
+    return store.Current();
+}
+
+std::uint32_t ParkourTuning::Version() {
+    return store.Version();
+}
@@ -41,8 +41,8 @@
 //    headNode->UpdateDownwardPass(upd, /* arg2 = */ 0);
 //}
 
-bool ParkourUtility::IsParkourActive() {
-    if (RuntimeVariables::selectedLedgeType == ParkourType::NoLedge) {
+bool ParkourUtility::IsParkourActive(int ledgeType) {
+    if (ledgeType == ParkourType::NoLedge) {
         return false;
     }
     const auto player = RE::PlayerCharacter::GetSingleton();
@@ -169,91 +169,38 @@ bool ParkourUtility::ToggleControlsForParkour(bool enable) {
     return true;
 }
 
-RE::NiPoint3 ParkourUtility::GetPlayerDirFlat(RE::Actor *player) {
-    // Calculate player forward direction (normalized)
-    const float playerYaw = player->data.angle.z;  // Player's yaw
+ParkourCore::PlayerState ParkourUtility::CapturePlayerState(RE::PlayerCharacter *player, const ModSettings::Settings &settings) {
+    ParkourCore::PlayerState state;
+    state.position = ToVec3(player->GetPosition());
+    state.yaw = player->data.angle.z;  // Player's yaw
+    state.scale = RuntimeVariables::PlayerScale;
 
-    RE::NiPoint3 playerDirFlat{std::sin(playerYaw), std::cos(playerYaw), 0};
-    const float dirMagnitude = std::hypot(playerDirFlat.x, playerDirFlat.y);
-    playerDirFlat.x /= dirMagnitude;
-    playerDirFlat.y /= dirMagnitude;
+    state.isMoving = player->IsMoving();
+    state.isGroundedOrSliding = PlayerIsGroundedOrSliding();
+    state.isMidairAndNotSliding = PlayerIsMidairAndNotSliding();
+    state.isSwimming = PlayerIsSwimming();
+    state.isOnStairs = PlayerIsOnStairs();
+    state.shouldReplaceWithFailed = ShouldReplaceMarkerWithFailed(settings);
 
-    return playerDirFlat;
-}
-
-void ParkourUtility::LastObjectHitType(RE::COL_LAYER obj) {
-    RuntimeVariables::lastHitObject = obj;
-}
-
-float ParkourUtility::RayCast(RE::NiPoint3 rayStart, RE::NiPoint3 rayDir, float maxDist, RE::hkVector4 &normalOut,
-                              RE::COL_LAYER layerMask) {
-    const auto player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        normalOut = RE::hkVector4(0.0f, 0.0f, 0.0f, 0.0f);
-        return maxDist;  // Return maxDist if player is null
-    }
+    float waterLevel;
     const auto cell = player->GetParentCell();
-    if (!cell) {
-        normalOut = RE::hkVector4(0.0f, 0.0f, 0.0f, 0.0f);
-        return maxDist;  // Return maxDist if cell is unavailable
-    }
-    const auto bhkWorld = cell->GetbhkWorld();
-    if (!bhkWorld) {
-        normalOut = RE::hkVector4(0.0f, 0.0f, 0.0f, 0.0f);
-        return maxDist;  // Return maxDist if Havok world is unavailable
+    if (cell && cell->GetWaterHeight(player->GetPosition(), waterLevel)) {
+        state.waterHeight = waterLevel;
     }
 
-    RE::bhkPickData pickData;
-    const auto havokWorldScale = RE::bhkWorld::GetWorldScale();
+    RE::NiPoint3 velocity;
+    player->GetLinearVelocity(velocity);
+    state.velocity = ToVec3(velocity);
 
-    // Set ray start and end points (scaled to Havok world)
-    pickData.rayInput.from = rayStart * havokWorldScale;
-    pickData.rayInput.to = (rayStart + rayDir * maxDist) * havokWorldScale;
-
-    // Set the collision filter info to exclude the player
-    uint32_t collisionFilterInfo = 0;
-    player->GetCollisionFilterInfo(collisionFilterInfo);
-    pickData.rayInput.filterInfo = (collisionFilterInfo & 0xFFFF0000) | static_cast<uint32_t>(layerMask);
-
-    // Perform the raycast
-    if (bhkWorld->PickObject(pickData) && pickData.rayOutput.HasHit()) {
-        normalOut = pickData.rayOutput.normal;
-
-        const uint32_t layerIndex = pickData.rayOutput.rootCollidable->broadPhaseHandle.collisionFilterInfo & 0x7F;
-        LastObjectHitType(static_cast<RE::COL_LAYER>(layerIndex));
-
-        if (layerIndex == 0) {
-            return -1.0f;  // Invalid layer hit
-        }
-
-        // Optionally log the layer hit
-        // if (logLayer) logger::info("\nLayer hit: {}", layerIndex);
-
-        // Check for useful collision layers
-        switch (RuntimeVariables::lastHitObject) {
-            case RE::COL_LAYER::kStatic:
-            case RE::COL_LAYER::kCollisionBox:
-            case RE::COL_LAYER::kTerrain:
-            case RE::COL_LAYER::kGround:
-            case RE::COL_LAYER::kProps:
-            case RE::COL_LAYER::kDoorDetection:
-            case RE::COL_LAYER::kTrees:
-            case RE::COL_LAYER::kClutterLarge:
-            case RE::COL_LAYER::kAnimStatic:
-            case RE::COL_LAYER::kDebrisLarge:
-                // Update last hit object type
-                return maxDist * pickData.rayOutput.hitFraction;
-
-            default:
-                return -1.0f;  // Ignore unwanted layers
+    // TDM moves first and turns after, the velocity shows where the player is going
+    if (Compatibility::TrueDirectionalMovement) {
+        const float speed = ParkourCore::MagnitudeXY(velocity.x, velocity.y);
+        if (speed > 1.0f) {
+            state.moveDir = {velocity.x / speed, velocity.y / speed, 0.0f};
         }
     }
 
-    // No hit
-    normalOut = RE::hkVector4(0.0f, 0.0f, 0.0f, 0.0f);
-    // if (logLayer) logger::info("Nothing hit");
-
-    return maxDist;
+    return state;
 }
 
 bool ParkourUtility::IsPlayerUsingFurniture(RE::PlayerCharacter *player) {
@@ -287,19 +234,19 @@ bool ParkourUtility::IsPlayerInSyncedAnimation(RE::PlayerCharacter *player) {
     return player->GetGraphVariableBool("bIsSynced", out) && out;
 }
 
-float ParkourUtility::CalculateParkourStamina() {
+float ParkourUtility::CalculateParkourStamina(const ModSettings::Settings &settings) {
     const auto player = RE::PlayerCharacter::GetSingleton();
     float equip = player->GetEquippedWeight();
     //float carry = player->GetTotalCarryWeight();
 
-    return ModSettings::Stamina_Damage + (equip * 0.2f);
+    return settings.Stamina_Damage + (equip * 0.2f);
 }
 
-bool ParkourUtility::PlayerHasEnoughStamina() {
+bool ParkourUtility::PlayerHasEnoughStamina(const ModSettings::Settings &settings) {
     const auto player = RE::PlayerCharacter::GetSingleton();
     const auto currentStamina = player->AsActorValueOwner()->GetActorValue(RE::ActorValue::kStamina);
 
-    if (!ModSettings::Is_Stamina_Required || currentStamina > CalculateParkourStamina() /* && ModSettings::Is_Stamina_Required */) {
+    if (!settings.Is_Stamina_Required || currentStamina > CalculateParkourStamina(settings) /* && Is_Stamina_Required */) {
         return true;
     }
     return false;
@@ -313,11 +260,11 @@ bool ParkourUtility::DamageActorStamina(RE::Actor *actor, float amount) {
     return false;
 }
 
-bool ParkourUtility::ShouldReplaceMarkerWithFailed() {
+bool ParkourUtility::ShouldReplaceMarkerWithFailed(const ModSettings::Settings &settings) {
     // If stamina options are on, check if player has enough stamina. If not, play failed anim. If stamina is on but
     // isn't required, just deal stamina damage. Only for med and high climbing, would get annoying fast.
-    if (ModSettings::Enable_Stamina_Consumption && !PlayerIsSwimming()) {
-        if (PlayerHasEnoughStamina() == false) {
+    if (settings.Enable_Stamina_Consumption && !PlayerIsSwimming()) {
+        if (PlayerHasEnoughStamina(settings) == false) {
             return true;
         }
     }
@@ -2,222 +2,64 @@
 
 using namespace ParkourUtility;
 
-int Parkouring::LedgeCheck(RE::NiPoint3 &ledgePoint, RE::NiPoint3 checkDir, float minLedgeHeight, float maxLedgeHeight) {
-    const auto player = RE::PlayerCharacter::GetSingleton();
-    const auto playerPos = player->GetPosition();
-
-    // Constants adjusted for player scale
-    const float startZOffset = 100 * RuntimeVariables::PlayerScale;
-    const float playerHeight = 120 * RuntimeVariables::PlayerScale;
-    const float minUpCheck = 100 * RuntimeVariables::PlayerScale;
-    const float maxUpCheck = (maxLedgeHeight - startZOffset) + 20 * RuntimeVariables::PlayerScale;
-    const float fwdCheckStep = 8 * RuntimeVariables::PlayerScale;
-    const int fwdCheckIterations = 10;   // 15
-    const float minLedgeFlatness = 0.5;  //0.5
-    const float ledgeHypotenuse = 1.0;   // 0.75 - larger is more relaxed, lesser is more strict. Don't set 0
-
-    RE::hkVector4 normalOut(0, 0, 0, 0);
-
-    // Upward raycast to check for headroom
-    RE::NiPoint3 upRayStart = playerPos + RE::NiPoint3(0, 0, startZOffset);
-    RE::NiPoint3 upRayDir(0, 0, 1);
-
-    float upRayDist = RayCast(upRayStart, upRayDir, maxUpCheck, normalOut, RE::COL_LAYER::kLOS);
-    if (upRayDist < minUpCheck) {
-        return ParkourType::NoLedge;
-    }
-
-    // Forward raycast initialization
-    RE::NiPoint3 fwdRayStart = upRayStart + upRayDir * (upRayDist - 10);
-    RE::NiPoint3 downRayDir(0, 0, -1);
-
-    bool foundLedge = false;
-    float normalZ = 0;
-
-    // Incremental forward raycast to find a ledge
-    for (int i = 0; i < fwdCheckIterations; i++) {
-        float fwdRayDist = RayCast(fwdRayStart, checkDir, fwdCheckStep * i, normalOut, RE::COL_LAYER::kLOS);
-        if (fwdRayDist < fwdCheckStep * i) {
-            continue;
-        }
-
-        // Downward raycast to detect ledge point
-        RE::NiPoint3 downRayStart = fwdRayStart + checkDir * fwdRayDist;
-        float downRayDist = RayCast(downRayStart, downRayDir, startZOffset + maxUpCheck, normalOut, RE::COL_LAYER::kLOS);
-
-        ledgePoint = downRayStart + downRayDir * downRayDist;
-        normalZ = normalOut.quad.m128_f32[2];
-
-        // Validate ledge based on height and flatness
-        if (ledgePoint.z < playerPos.z + minLedgeHeight || ledgePoint.z > playerPos.z + maxLedgeHeight || downRayDist < 10 ||
-            normalZ < minLedgeFlatness) {
-            continue;
-        }
-
-        // Backward ray to check for obstructions behind the vaultable surface
-        RE::NiPoint3 backwardRayStart = fwdRayStart + checkDir * (fwdRayDist - 2) + RE::NiPoint3(0, 0, 5);
-        const float maxObstructionDistance = 10.0f * RuntimeVariables::PlayerScale;
-        float backwardRayDist = RayCast(backwardRayStart, checkDir, maxObstructionDistance, normalOut, RE::COL_LAYER::kLOS);
-
-        if (backwardRayDist > 0 && backwardRayDist < maxObstructionDistance) {
-            continue;  // Obstruction behind the vaultable surface
-        }
-
-        foundLedge = true;
-        break;
-    }
-
-    if (!foundLedge) {
-        return ParkourType::NoLedge;
-    }
-
-    // Ensure there is sufficient headroom for the player to stand
-    float headroomBuffer = 10 * RuntimeVariables::PlayerScale;
-    RE::NiPoint3 headroomRayStart = ledgePoint + upRayDir * headroomBuffer;
-    float headroomRayDist = RayCast(headroomRayStart, upRayDir, playerHeight - headroomBuffer, normalOut, RE::COL_LAYER::kLOS);
-
-    if (headroomRayDist < playerHeight - headroomBuffer) {
-        return ParkourType::NoLedge;
-    }
-
-    float ledgePlayerDiff = ledgePoint.z - playerPos.z;
-    if (PlayerIsGroundedOrSliding() || PlayerIsSwimming()) {
-        if (ledgePlayerDiff >= HardCodedVariables::highestLedgeLimit * RuntimeVariables::PlayerScale) {
-            if (ShouldReplaceMarkerWithFailed()) {
-                return ParkourType::Failed;
-            }
-            return ParkourType::Highest;  // Highest ledge
-        }
-        else if (ledgePlayerDiff >= HardCodedVariables::highLedgeLimit * RuntimeVariables::PlayerScale) {
-            if (ShouldReplaceMarkerWithFailed()) {
-                return ParkourType::Failed;
-            }
-            return ParkourType::High;  // High ledge
-        }
-        else if (ledgePlayerDiff >= HardCodedVariables::medLedgeLimit * RuntimeVariables::PlayerScale) {
-            return ParkourType::Medium;  // Medium ledge
-        }
-        else if (ledgePlayerDiff >= HardCodedVariables::lowLedgeLimit * RuntimeVariables::PlayerScale) {
-            if (PlayerIsSwimming()) {
-                return ParkourType::Grab;  // Grab ledge out of water, don't jump out like a frog
-            }
-
-            return ParkourType::Low;  // Low ledge
-        }
-        else if (ledgePlayerDiff >= HardCodedVariables::highStepLimit * RuntimeVariables::PlayerScale) {
-            if (PlayerIsSwimming()) {
-                return ParkourType::Grab;  // Grab ledge out of water, don't step out
-            }
-
-            // Additional horizontal and vertical checks for low ledge
-            double horizontalDistance = sqrt(pow(ledgePoint.x - playerPos.x, 2) + pow(ledgePoint.y - playerPos.y, 2));
-            double verticalDistance = abs(ledgePlayerDiff);
-
-            if (horizontalDistance < verticalDistance * ledgeHypotenuse) {
-                return ParkourType::StepHigh;  // High Step
-            }
-        }
-        else {
-            if (PlayerIsSwimming()) {
-                return ParkourType::Grab;  // Grab ledge out of water, don't step out
-            }
-
-            // Additional horizontal and vertical checks for low ledge
-            double horizontalDistance = sqrt(pow(ledgePoint.x - playerPos.x, 2) + pow(ledgePoint.y - playerPos.y, 2));
-            double verticalDistance = abs(ledgePlayerDiff);
-
-            if (!PlayerIsOnStairs() && horizontalDistance < verticalDistance * ledgeHypotenuse) {
-                return ParkourType::StepLow;  // Low Step
-            }
-        }
-    }
-    else if (PlayerIsMidairAndNotSliding() && ledgePlayerDiff > -35 && ledgePlayerDiff <= 100 * RuntimeVariables::PlayerScale) {
-        if (!PlayerIsOnStairs()) {
-            return ParkourType::Grab;
-        }
-    }
-    return ParkourType::NoLedge;
+// Input events can arrive several times per frame, detection should run at most once per frame
+static ParkourCore::FrameCoalescer parkourPointUpdates;
+// Standing still repeats the same decision, reuse it until the pose, cell or scale changes
+static ParkourCore::DetectionCache detectionCache;
+// Rebuilt only when the player scale or the tuning file changes. thresholds is tunedThresholds at the quality tier.
+static ParkourCore::ScaledThresholds tunedThresholds;
+static ParkourCore::ScaledThresholds thresholds;
+static std::uint32_t thresholdsVersion = 0;
+// Quality tier for Quality.Tier = Auto, fed every frame by SampleFrameTime
+static ParkourCore::QualityGovernor qualityGovernor;
+// A decision spread over several updates when the tuning sets a frame budget
+static ParkourCore::DetectionJob detectionJob;
+static Scheduler::Handle detectionJobResume;
+
+// One slice of the running decision, or with finish all that is left of it. Remembered in the cache once done.
+static std::optional<RuntimeVariables::Detection> StepDetectionJob(ParkourCore::WorldQuery &world, bool finish) {
+    const ParkourCore::SliceBudget budget{thresholds.sliceCasts, static_cast<std::uint32_t>(thresholds.sliceMicroseconds)};
+    if (finish) {
+        detectionJob.Finish(world);
+    }
+    else if (!detectionJob.Step(world, budget)) {
+        return std::nullopt;
+    }
+
+    const auto nowMs = SteadyNowMs();
+    detectionCache.Remember(world, detectionJob.Player(), thresholds, detectionJob.SmartParkour(), detectionJob.Result(),
+                            detectionJob.Casts(), nowMs);
+    return RuntimeVariables::Detection{detectionJob.Result(), nowMs, detectionJob.FramesSpanned()};
 }
-int Parkouring::VaultCheck(RE::NiPoint3 &ledgePoint, RE::NiPoint3 checkDir, float vaultLength, float maxElevationIncrease,
-                           float minVaultHeight, float maxVaultHeight) {
-    const auto player = RE::PlayerCharacter::GetSingleton();
-
-    if (!PlayerIsGroundedOrSliding()) {
-        return ParkourType::NoLedge;
-    }
-
-    const auto playerPos = player->GetPosition();
-
-    RE::hkVector4 normalOut(0, 0, 0, 0);
-
-    float headHeight = 120 * RuntimeVariables::PlayerScale;
-
-    // Forward raycast to check for a vaultable surface
-    RE::NiPoint3 fwdRayStart = playerPos + RE::NiPoint3(0, 0, headHeight);
-    float fwdRayDist = RayCast(fwdRayStart, checkDir, vaultLength, normalOut, RE::COL_LAYER::kLOS);
-
-    if (RuntimeVariables::lastHitObject == RE::COL_LAYER::kTerrain || fwdRayDist < vaultLength) {
-        return ParkourType::NoLedge;  // Not vaultable if terrain or insufficient distance
-    }
-
-    // Backward ray to check for obstructions behind the vaultable surface
-    RE::NiPoint3 backwardRayStart = fwdRayStart + checkDir * (fwdRayDist - 2) + RE::NiPoint3(0, 0, 5);
-    const float maxObstructionDistance = 100.0f * RuntimeVariables::PlayerScale;
-    float backwardRayDist = RayCast(backwardRayStart, checkDir, maxObstructionDistance, normalOut, RE::COL_LAYER::kLOS);
 
-    if (backwardRayDist > 0 && backwardRayDist < maxObstructionDistance) {
-        return ParkourType::NoLedge;  // Obstruction behind the vaultable surface
-    }
-
-    // Downward raycast initialization
-    int downIterations = /*static_cast<int>(std::floor(vaultLength / 5.0f))*/ 20;
-    RE::NiPoint3 downRayDir(0, 0, -1);
-
-    bool foundVaulter = false;
-    float foundVaultHeight = -10000.0f;
-    bool foundLanding = false;
-    float foundLandingHeight = 10000.0f;
-
-    // Incremental downward raycasts
-    for (int i = 0; i < downIterations; i++) {
-        float iDist = static_cast<float>(i) * 5.0f;
-        RE::NiPoint3 downRayStart = playerPos + checkDir * iDist;
-        downRayStart.z = fwdRayStart.z;
-
-        float downRayDist = RayCast(downRayStart, downRayDir, headHeight + 100.0f, normalOut, RE::COL_LAYER::kLOS);
-        float hitHeight = (fwdRayStart.z - downRayDist) - playerPos.z;
-
-        // Check hit height for vaultable surfaces
-        if (hitHeight > maxVaultHeight) {
-            return ParkourType::NoLedge;  // Too high to vault
-        }
-        else if (hitHeight > minVaultHeight && hitHeight < maxVaultHeight) {
-            if (hitHeight >= foundVaultHeight) {
-                foundVaultHeight = hitHeight;
-                foundLanding = false;
-            }
-            ledgePoint = downRayStart + downRayDir * downRayDist;
-            foundVaulter = true;
-        }
-        else if (foundVaulter && hitHeight < minVaultHeight) {
-            foundLandingHeight = std::min(hitHeight, foundLandingHeight);
-            foundLanding = true;
-        }
+// One prediction per jump or fall, refreshed while the player stays on its path
+static ParkourCore::GrabPredictor grabPredictor;
+// At most one pending retry for a button press just before a predicted grab
+static Scheduler::Handle grabRetry;
+// TDM heading, scanned again when the movement input changes
+static ParkourCore::HeadingTracker headingTracker;
+
+// Pressed just before a predicted grab window, try again when it opens instead of dropping the input
+static void RetryAtPredictedGrab() {
+    const auto untilMs = grabPredictor.MsUntilWindow(SteadyNowMs());
+    if (untilMs < 0 || grabRetry.IsValid()) {
+        return;
     }
 
-    // Final validation for vault
-    if (foundVaulter && foundLanding && foundLandingHeight < maxElevationIncrease) {
-        ledgePoint.z = playerPos.z + foundVaultHeight;
-        if (!PlayerIsOnStairs()) {
-            return ParkourType::Vault;  // Vault successful
+    grabRetry = Scheduler::AfterMs(static_cast<std::uint32_t>(untilMs), [] {
+        grabRetry = {};
+        const auto nowMs = SteadyNowMs();
+        const auto due = grabPredictor.Due(nowMs);
+        if (!due || !PlayerIsMidairAndNotSliding()) {
+            return;
         }
-    }
-
-    return ParkourType::NoLedge;  // Vault failed
+        RuntimeVariables::detection.Store({*due, nowMs});
+        Parkouring::TryActivateParkour(ModSettings::Get());
+    });
 }
 
-bool Parkouring::PlaceAndShowIndicator() {
-    if (ModSettings::UseIndicators == false) {
+bool Parkouring::PlaceAndShowIndicator(const ParkourCore::DetectionResult &detection, const ModSettings::Settings &settings) {
+    if (settings.UseIndicators == false) {
         return false;
     }
 
@@ -227,8 +69,8 @@ bool Parkouring::PlaceAndShowIndicator() {
 
     // Choose indicator depending on stamina
     GameReferences::currentIndicatorRef = GameReferences::indicatorRef_Blue;  // Default to blue
-    if (ModSettings::Enable_Stamina_Consumption && PlayerHasEnoughStamina() == false &&
-        CheckIsVaultActionFromType(RuntimeVariables::selectedLedgeType) == false) {
+    if (settings.Enable_Stamina_Consumption && PlayerHasEnoughStamina(settings) == false &&
+        CheckIsVaultActionFromType(detection.ledgeType) == false) {
         GameReferences::currentIndicatorRef = GameReferences::indicatorRef_Red;
         GameReferences::indicatorRef_Blue->Disable();
     }
@@ -243,12 +85,12 @@ bool Parkouring::PlaceAndShowIndicator() {
     }
 
     GameReferences::currentIndicatorRef->data.location =
-        RuntimeVariables::ledgePoint + RE::NiPoint3(0, 0, 10);  // Offset upwards slightly, 5 -> 10
+        ToNiPoint3(detection.ledgePoint) + RE::NiPoint3(0, 0, 10);  // Offset upwards slightly, 5 -> 10
 
     GameReferences::currentIndicatorRef->Update3DPosition(true);
 
     GameReferences::currentIndicatorRef->data.angle =
-        RE::NiPoint3(0, 0, atan2(RuntimeVariables::playerDirFlat.x, RuntimeVariables::playerDirFlat.y));
+        RE::NiPoint3(0, 0, atan2(detection.playerDirFlat.x, detection.playerDirFlat.y));
 
     if (!RuntimeVariables::IsParkourActive) {
         if (GameReferences::currentIndicatorRef)
@@ -262,51 +104,58 @@ bool Parkouring::PlaceAndShowIndicator() {
     return true;
 }
 
-int Parkouring::GetLedgePoint(float backwardOffset = 55.0f) {
-    using namespace GameReferences;
-    using namespace ModSettings;
-
+std::optional<RuntimeVariables::Detection> Parkouring::GetLedgePoint(const ModSettings::Settings &settings) {
     const auto player = RE::PlayerCharacter::GetSingleton();
-    //const auto playerPos = player->GetPosition();
-    const bool isMoving = player->IsMoving();
 
-    RE::NiPoint3 playerDirFlat = GetPlayerDirFlat(player);
+    // One world context for every ray of this decision
+    HavokWorldQuery world(player);
+    if (!world.IsValid()) {
+        return RuntimeVariables::Detection{{}, SteadyNowMs()};
+    }
 
-    // Perform ledge or vault checks
-    int selectedLedgeType = ParkourType::NoLedge;
-    RE::NiPoint3 ledgePoint;
+    auto state = CapturePlayerState(player, settings);
+    const auto cell = player->GetParentCell();
+    detectionCache.SetContext(cell ? cell->GetFormID() : 0, state.scale);
+    const bool smartParkour = settings.Smart_Parkour_Enabled;
 
-    if (isMoving || !ModSettings::Smart_Parkour_Enabled) {
-        selectedLedgeType = VaultCheck(ledgePoint, playerDirFlat, 85, 70 * RuntimeVariables::PlayerScale,
-                                       HardCodedVariables::vaultMinHeight * RuntimeVariables::PlayerScale,
-                                       HardCodedVariables::vaultMaxHeight * RuntimeVariables::PlayerScale);
+    const auto nowMs = SteadyNowMs();
+    if (thresholds.grabPrediction) {
+        grabPredictor.Update(world, state, thresholds, nowMs);  // Resets itself once the player is grounded
     }
 
-    if (selectedLedgeType == ParkourType::NoLedge) {
-        selectedLedgeType = LedgeCheck(ledgePoint, playerDirFlat, HardCodedVariables::climbMinHeight * RuntimeVariables::PlayerScale,
-                                       HardCodedVariables::climbMaxHeight * RuntimeVariables::PlayerScale);
-    }
-    if (selectedLedgeType == ParkourType::NoLedge) {
-        return ParkourType::NoLedge;
+    // 360 parkour, ledges to the side count before TDM has turned the character. The decision looks along the heading
+    // the tracker picked, a scan's best is that decision already, so the cache answers it below.
+    if (Compatibility::TrueDirectionalMovement && !detectionJob.Running()) {
+        std::optional<ParkourCore::HeadingScanResult> scan;
+        state.yaw = headingTracker.Update(world, state, thresholds, smartParkour, state.moveDir, scan);
+        if (scan && scan->best.ledgeType != ParkourType::NoLedge) {
+            detectionCache.Remember(world, state, thresholds, smartParkour, scan->best, scan->casts, nowMs);
+        }
     }
 
-    // Don't ever parkour into water, last check before saying this ledge is valid
-    float waterLevel;
-    player->GetParentCell()->GetWaterHeight(player->GetPosition(), waterLevel);  //Relative to player
-
-    if (ledgePoint.z < waterLevel - 10) {
-        return ParkourType::NoLedge;
+    // With a frame budget a decision the cache can't answer runs as a job, the last one stays published until it is done
+    std::optional<RuntimeVariables::Detection> detection = RuntimeVariables::Detection{{}, nowMs};
+    if (thresholds.sliceCasts <= 0 && thresholds.sliceMicroseconds <= 0) {
+        detection->result = detectionCache.GetLedgePoint(world, state, thresholds, smartParkour, nowMs);
+    }
+    else if (detectionJob.Running()) {
+        detection = StepDetectionJob(world, false);
+    }
+    else if (const auto answer = detectionCache.Answer(world, state, thresholds, smartParkour, nowMs)) {
+        detection->result = *answer;
+    }
+    else {
+        detectionJob.Start(state, thresholds, smartParkour);
+        detection = StepDetectionJob(world, false);
     }
 
-    // RE::NiPoint3 cameraDirFlat = GetCameraDirFlat();
-
-    RE::NiPoint3 backwardAdjustment = playerDirFlat * backwardOffset * RuntimeVariables::PlayerScale;
-
-    RuntimeVariables::backwardAdjustment = backwardAdjustment;
-    RuntimeVariables::ledgePoint = ledgePoint;
-    RuntimeVariables::playerDirFlat = playerDirFlat;
-
-    return selectedLedgeType;
+    // Between input events the player can fly past the grab range, the prediction knows when it is in reach
+    if (!detection || detection->result.ledgeType == ParkourType::NoLedge) {
+        if (const auto due = grabPredictor.Due(nowMs)) {
+            return RuntimeVariables::Detection{*due, nowMs};
+        }
+    }
+    return detection;
 }
 void Parkouring::InterpolateRefToPosition(RE::TESObjectREFR *obj, RE::NiPoint3 position, float speed = 500.0f, int timeoutMS = 500) {
     auto vm = RE::BSScript::Internal::VirtualMachine::GetSingleton();
@@ -357,129 +206,183 @@ void Parkouring::InterpolateRefToPosition(RE::TESObjectREFR *obj, RE::NiPoint3 p
                             args,          // packed arguments
                             result);
 
-    _THREAD_POOL.enqueue([vm, handle, timeoutMS]() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMS));
-        SKSE::GetTaskInterface()->AddTask([vm, handle]() {
-            auto args = RE::MakeFunctionArguments();
-
-            RE::BSTSmartPointer<RE::BSScript::Object> object;
-            if (!vm->FindBoundObject(handle, "StopTranslation", object)) {
-                return;
-            }
-            RE::BSTSmartPointer<RE::BSScript::IStackCallbackFunctor> result;
-            vm->DispatchMethodCall1(object,  // the Papyrus ObjectReference instance
-                                    "StopTranslation",
-                                    args,  // packed arguments
-                                    result);
-        });
+    // Main thread callback, no worker sleeps through the timeout
+    Scheduler::AfterMs(static_cast<std::uint32_t>(std::max(timeoutMS, 0)), [vm, handle]() {
+        auto args = RE::MakeFunctionArguments();
+
+        RE::BSTSmartPointer<RE::BSScript::Object> object;
+        if (!vm->FindBoundObject(handle, "StopTranslation", object)) {
+            return;
+        }
+        RE::BSTSmartPointer<RE::BSScript::IStackCallbackFunctor> result;
+        vm->DispatchMethodCall1(object,  // the Papyrus ObjectReference instance
+                                "StopTranslation",
+                                args,  // packed arguments
+                                result);
     });
 }
 
-void Parkouring::AdjustPlayerPosition(int ledgeType) {
+void Parkouring::AdjustPlayerPosition(const ParkourCore::DetectionResult &detection) {
     const auto player = RE::PlayerCharacter::GetSingleton();
+    const int ledgeType = detection.ledgeType;
+    const auto playerDirFlat = ToNiPoint3(detection.playerDirFlat);
+    const auto ledgePoint = ToNiPoint3(detection.ledgePoint);
+    auto backwardAdjustment = ToNiPoint3(detection.backwardAdjustment);
 
     // Select appropriate ledge marker and adjustments
-    // switch takes constants so can't pass these from references.h, here's the lookup table
-
-    float zAdjust = 0;
-    float z = 0;
-    //const int Highest = 8;
-    //const int High = 7;
-    //const int Medium = 6;
-    //const int Low = 5;
-    //const int StepHigh = 4;
-    //const int StepLow = 3;
-    //const int Vault = 2;
-    //const int Grab = 1;
-    //const int Failed = 0;
-    //const int NoLedge = -1;
-
     switch (ledgeType) {
-        case 8:  // Highest Ledge
-            z = HardCodedVariables::highestLedgeElevation - 3;
-            zAdjust = -z * RuntimeVariables::PlayerScale;
-            break;
-
-        case 7:  // High ledge
-            z = HardCodedVariables::highLedgeElevation - 3;
-            zAdjust = -z * RuntimeVariables::PlayerScale;
-            break;
-
-        case 6:  // Medium ledge
-            z = HardCodedVariables::medLedgeElevation - 3;
-            zAdjust = -z * RuntimeVariables::PlayerScale;
+        case ParkourType::Highest:
+        case ParkourType::High:
+        case ParkourType::Medium:
+        case ParkourType::Low:
+        case ParkourType::Vault:
             break;
 
-        case 5:  // Low ledge
-            z = HardCodedVariables::lowLedgeElevation - 3;
-            zAdjust = -z * RuntimeVariables::PlayerScale;
+        case ParkourType::StepHigh:
+        case ParkourType::StepLow:
+            // Override backward offset
+            backwardAdjustment = playerDirFlat * thresholds.stepBackwardOffset;
             break;
 
-        case 4:  // Step High
-            z = HardCodedVariables::stepHighElevation - 5;
-            zAdjust = -z * RuntimeVariables::PlayerScale;
-            RuntimeVariables::backwardAdjustment =
-                RuntimeVariables::playerDirFlat * 30 * RuntimeVariables::PlayerScale;  // Override backward offset
+        case ParkourType::Grab:  // Midair or Out of Water
+            // Override backward offset
+            backwardAdjustment = playerDirFlat * thresholds.grabBackwardOffset;
             break;
 
-        case 3:  // Step Low
-            z = HardCodedVariables::stepLowElevation - 5;
-            zAdjust = -z * RuntimeVariables::PlayerScale;
-            RuntimeVariables::backwardAdjustment =
-                RuntimeVariables::playerDirFlat * 30 * RuntimeVariables::PlayerScale;  // Override backward offset
-            break;
-
-        case 2:  // Vault
-            z = HardCodedVariables::vaultElevation - 3;
-            zAdjust = -z * RuntimeVariables::PlayerScale;
-            break;
-
-        case 1:  // Grab (Midair or Out of Water)
-            z = HardCodedVariables::grabElevation - 3;
-            zAdjust = -z * RuntimeVariables::PlayerScale;
-            RuntimeVariables::backwardAdjustment =
-                RuntimeVariables::playerDirFlat * 40 * RuntimeVariables::PlayerScale;  // Override backward offset
-            break;
-
-        case 0:  // Failed (Low Stamina Animation)
+        case ParkourType::Failed:  // Low Stamina Animation
             return;
         default:
             logger::info("!!WARNING!! POSITION WAS NOT ADJUSTED, INVALID LEDGE TYPE {}", ledgeType);
             return;
     }
 
-    const auto newPosition =
-        RE::NiPoint3{RuntimeVariables::ledgePoint.x - RuntimeVariables::backwardAdjustment.x,
-                     RuntimeVariables::ledgePoint.y - RuntimeVariables::backwardAdjustment.y, RuntimeVariables::ledgePoint.z + zAdjust};
+    const float zAdjust = -thresholds.Elevation(ledgeType);
+
+    const auto newPosition = RE::NiPoint3{ledgePoint.x - backwardAdjustment.x, ledgePoint.y - backwardAdjustment.y, ledgePoint.z + zAdjust};
 
     Parkouring::InterpolateRefToPosition(player, newPosition);
 }
 
-void Parkouring::UpdateParkourPoint() {
+void Parkouring::UpdateParkourPoint(const ModSettings::Settings &settings) {
     if (RuntimeVariables::ParkourEndQueued) {
         if (GameReferences::currentIndicatorRef)
             GameReferences::currentIndicatorRef->Disable();
-        RuntimeVariables::selectedLedgeType = -1;
+        RuntimeVariables::detection.Store({});
+        detectionJob.Reset();
         return;
     }
 
-    RuntimeVariables::IsParkourActive = IsParkourActive();
+    RuntimeVariables::IsParkourActive = IsParkourActive(RuntimeVariables::detection.Load().result.ledgeType);
 
     RuntimeVariables::PlayerScale = ScaleUtility::GetScale();
-    RuntimeVariables::selectedLedgeType = GetLedgePoint();
+    const bool autoQuality = tunedThresholds.quality == ParkourCore::DetectionQuality::Auto;
+    if (thresholds.scale != RuntimeVariables::PlayerScale || thresholdsVersion != ParkourTuning::Version()) {
+        thresholdsVersion = ParkourTuning::Version();  // Before Current(), a reload in between only costs another rebuild
+        tunedThresholds = ParkourTuning::Current().Scaled(RuntimeVariables::PlayerScale);
+        const int tier = tunedThresholds.quality == ParkourCore::DetectionQuality::Auto ? qualityGovernor.Tier() : tunedThresholds.quality;
+        thresholds = ParkourCore::WithQuality(tunedThresholds, tier);
+        detectionCache.SetConfig({.ttlMs = static_cast<std::uint32_t>(tunedThresholds.cacheTtlMs)});  // Invalidates
+        detectionJob.Reset();
+        grabPredictor.Reset();
+        headingTracker.Reset();
+    }
+    else if (autoQuality && thresholds.quality != qualityGovernor.Tier()) {
+        // Cached decisions stay valid at any tier, a running job keeps the thresholds it started with
+        thresholds = ParkourCore::WithQuality(tunedThresholds, qualityGovernor.Tier());
+        logger::info("Detection quality tier {}", qualityGovernor.Tier());
+    }
+    const auto detection = GetLedgePoint(settings);
+    if (detectionJob.Running() && !detectionJobResume.IsValid()) {
+        // Next slice on the next frame, with or without new input
+        detectionJobResume = Scheduler::AfterFrames(1, [] {
+            detectionJobResume = {};
+            RequestParkourPointUpdate();
+        });
+    }
+    if (!detection) {
+        return;  // The last decision stays published until the sliced one is done
+    }
+    RuntimeVariables::detection.Store(*detection);
 
     // Indicator stuff
-    PlaceAndShowIndicator();
+    PlaceAndShowIndicator(detection->result, settings);
+}
+
+void Parkouring::RequestParkourPointUpdate() {
+    if (parkourPointUpdates.Request()) {
+        SKSE::GetTaskInterface()->AddTask([] {
+            parkourPointUpdates.BeginRun();
+            UpdateParkourPoint(ModSettings::Get());
+        });
+    }
+}
+
+// From the Main::Update hook, once per frame whether or not detection runs. A paused game's frames say nothing about
+// the cost of detection. The tier is picked up by the next update.
+void Parkouring::SampleFrameTime() {
+    if (tunedThresholds.quality != ParkourCore::DetectionQuality::Auto || RE::UI::GetSingleton()->GameIsPaused()) {
+        return;
+    }
+    qualityGovernor.AddFrame(RE::GetSecondsSinceLastFrame() * 1000.0f, tunedThresholds.qualityDownMs, tunedThresholds.qualityUpMs);
 }
 
-bool Parkouring::TryActivateParkour() {
+void Parkouring::LogParkourPointUpdateStats() {
+    logger::info("Parkour point updates: requested {}, executed {}", parkourPointUpdates.Requested(), parkourPointUpdates.Executed());
+
+    const auto &cacheStats = detectionCache.GetStats();
+    logger::info("Detection cache: {} lookups, hit rate {:.1f}%, rays cast {}, rays saved {}, invalidations {}", cacheStats.lookups,
+                 cacheStats.HitRate() * 100.0, cacheStats.raysCast, cacheStats.raysSaved, cacheStats.invalidations);
+
+    if (thresholds.negativeCache != ParkourCore::NegativeCacheMode::Off) {
+        const auto &negativeStats = detectionCache.Negative().GetStats();
+        logger::info("Negative cache: {} lookups, hit rate {:.1f}%, confirm failures {}, expired {}, stores {}, refused {}, evictions {}",
+                     negativeStats.lookups, negativeStats.HitRate() * 100.0, negativeStats.confirmFailures, negativeStats.expired,
+                     negativeStats.stores, negativeStats.refused, negativeStats.evictions);
+        logger::info("Negative cache: rays saved {}, confirm rays {}", negativeStats.raysSaved, negativeStats.raysCast);
+    }
+
+    if (thresholds.sliceCasts > 0 || thresholds.sliceMicroseconds > 0) {
+        const auto &jobStats = detectionJob.GetStats();
+        logger::info("Time sliced detection: {} decisions in {} slices, {} forced, {} abandoned, at most {} frames and {} casts a frame",
+                     jobStats.decisions, jobStats.slices, jobStats.forced, jobStats.abandoned, jobStats.maxFrames, jobStats.maxSliceCasts);
+    }
+
+    if (tunedThresholds.quality == ParkourCore::DetectionQuality::Auto) {
+        const auto &qualityStats = qualityGovernor.GetStats();
+        logger::info("Detection quality: tier {}, {} steps down, {} up, frames at low {}, medium {}, high {}", qualityGovernor.Tier(),
+                     qualityStats.stepsDown, qualityStats.stepsUp, qualityStats.framesAt[0], qualityStats.framesAt[1],
+                     qualityStats.framesAt[2]);
+    }
+
+    if (Compatibility::TrueDirectionalMovement) {
+        const auto &headingStats = headingTracker.GetStats();
+        logger::info("Heading scans: {} in {} decisions, {} casts", headingStats.scans, headingStats.updates, headingStats.scanCasts);
+    }
+}
+
+bool Parkouring::TryActivateParkour(const ModSettings::Settings &settings) {
     using namespace GameReferences;
-    using namespace ModSettings;
     const auto player = RE::PlayerCharacter::GetSingleton();
-    const auto LedgeToProcess = RuntimeVariables::selectedLedgeType;
+    // A time sliced decision still running is the freshest look at the ledge, finish it instead of acting on the last one
+    if (detectionJob.Running()) {
+        HavokWorldQuery world(player);
+        if (world.IsValid()) {
+            const auto finished = StepDetectionJob(world, true);
+            RuntimeVariables::detection.Store(*finished);
+            PlaceAndShowIndicator(finished->result, settings);
+        }
+    }
+
+    // One coherent detection for the whole activation
+    RuntimeVariables::Detection detection;
+    const auto generation = RuntimeVariables::detection.Load(detection);
+    const auto LedgeToProcess = detection.result.ledgeType;
     // Check Is Parkour Active again, make sure condition is still valid during activation
-    if (!IsParkourActive() || RuntimeVariables::ParkourEndQueued) {
+    if (!IsParkourActive(LedgeToProcess) || RuntimeVariables::ParkourEndQueued) {
         player->SetGraphVariableInt("SkyParkourLedge", ParkourType::NoLedge);
+        if (!RuntimeVariables::ParkourEndQueued) {
+            RetryAtPredictedGrab();
+        }
         return false;
     }
 
@@ -513,13 +416,16 @@ bool Parkouring::TryActivateParkour() {
         }
     }
 
-    if (Smart_Parkour_Enabled && isMoving) {
+    if (settings.Smart_Parkour_Enabled && isMoving) {
         if (!isVaultAction) {
             player->SetGraphVariableInt("SkyParkourLedge", ParkourType::NoLedge);
             return false;
         }
     }
 
+    logger::info("Activating ledge {} from detection {}, {} ms old, {} frames", LedgeToProcess, generation,
+                 SteadyNowMs() - detection.detectedAtMs, detection.framesSpanned);
+
     RuntimeVariables::ParkourEndQueued = true;
     player->SetGraphVariableInt("SkyParkourLedge", LedgeToProcess);
     ToggleControlsForParkour(false);
@@ -528,32 +434,38 @@ bool Parkouring::TryActivateParkour() {
     // But to check player swimming state, a frame must pass. So AdjustPlayerPosition is called, then parkour runs on next frame.
     // Also, ToggleControlsForParkour switches POVs, and it can crash the game if the player camera state is not updated.
     // MEANING THIS THING SHOULD RUN ON THE NEXT FRAME
-    SKSE::GetTaskInterface()->AddTask([LedgeToProcess]() { ParkourReadyRun(LedgeToProcess); });
+    SKSE::GetTaskInterface()->AddTask([result = detection.result]() { ParkourReadyRun(result); });
 
     return true;
 }
-void Parkouring::ParkourReadyRun(int ledge) {
+void Parkouring::ParkourReadyRun(const ParkourCore::DetectionResult &detection) {
     const auto player = RE::PlayerCharacter::GetSingleton();
 
     // Directional jumping state fails if it triggers too early, set it to standing jump
-    if (ledge == ParkourType::Grab && !PlayerIsSwimming()) {
+    if (detection.ledgeType == ParkourType::Grab && !PlayerIsSwimming()) {
         player->NotifyAnimationGraph("JumpStandingStart");
     }
 
+    // A heading scan can pick a ledge off the facing, turn to it before the animation starts
+    if (Compatibility::TrueDirectionalMovement) {
+        player->SetHeading(std::atan2(detection.playerDirFlat.x, detection.playerDirFlat.y));
+    }
+
     // Lock ledge to active one throughout the action;
-    RuntimeVariables::selectedLedgeType = ledge;
+    RuntimeVariables::activeParkour = detection;
     // Send Event, then check if succeeded in Graph notify hook
     player->NotifyAnimationGraph("IdleLeverPushStart");
 }
 void Parkouring::PostParkourStaminaDamage(RE::PlayerCharacter *player, bool isVault) {
-    if (ModSettings::Enable_Stamina_Consumption) {
-        float cost = ParkourUtility::CalculateParkourStamina();
+    const auto settings = ModSettings::Get();
+    if (settings.Enable_Stamina_Consumption) {
+        float cost = ParkourUtility::CalculateParkourStamina(settings);
 
         if (isVault) {
             // logger::info("cost{}", cost / 2);
             DamageActorStamina(player, cost / 2);
         }
-        else if (PlayerHasEnoughStamina()) {
+        else if (PlayerHasEnoughStamina(settings)) {
             // logger::info("cost{}", cost);
             DamageActorStamina(player, cost);
         }
@@ -11,38 +11,43 @@
 using namespace ParkourUtility;
 using namespace Parkouring;
 
+// Each register call publishes one new settings snapshot, related values change together
 void RegisterCustomParkourKey(RE::StaticFunctionTag *, int32_t dxcode) {
-    ButtonStates::DXCODE = dxcode;
+    ModSettings::Update([=](ModSettings::Settings &s) { s.CustomParkourKey = dxcode; });
     logger::info(">Custom Key: '{}'", dxcode);
 }
 
 void RegisterPresetParkourKey(RE::StaticFunctionTag *, int32_t presetKey) {
-    ModSettings::PresetParkourKey = presetKey;
-    logger::info(">Preset Key: '{}'", ModSettings::PresetParkourKey);
+    const auto settings = ModSettings::Update([=](ModSettings::Settings &s) { s.PresetParkourKey = presetKey; });
+    logger::info(">Preset Key: '{}'", settings.PresetParkourKey);
 }
 
 void RegisterParkourDelay(RE::StaticFunctionTag *, float delay) {
-    ModSettings::parkourDelay = delay;
-    logger::info(">Delay '{}'", ModSettings::parkourDelay);
+    const auto settings = ModSettings::Update([=](ModSettings::Settings &s) { s.parkourDelay = delay; });
+    logger::info(">Delay '{}'", settings.parkourDelay);
 }
 
 void RegisterStaminaDamage(RE::StaticFunctionTag *, bool enabled, bool staminaBlocks, float damage) {
-    ModSettings::Enable_Stamina_Consumption = enabled;
-    ModSettings::Is_Stamina_Required = staminaBlocks;
-    ModSettings::Stamina_Damage = damage;
-    logger::info("|Stamina|> On:'{}' >Must:'{}' >Dmg:'{}'", ModSettings::Enable_Stamina_Consumption, ModSettings::Is_Stamina_Required,
-                 ModSettings::Stamina_Damage);
+    const auto settings = ModSettings::Update([=](ModSettings::Settings &s) {
+        s.Enable_Stamina_Consumption = enabled;
+        s.Is_Stamina_Required = staminaBlocks;
+        s.Stamina_Damage = damage;
+    });
+    logger::info("|Stamina|> On:'{}' >Must:'{}' >Dmg:'{}'", settings.Enable_Stamina_Consumption, settings.Is_Stamina_Required,
+                 settings.Stamina_Damage);
 }
 
 void RegisterParkourSettings(RE::StaticFunctionTag *, bool _usePresetKey, bool _enableMod, bool _smartParkour, bool _useIndicators) {
-    ModSettings::UsePresetParkourKey = _usePresetKey;
-    ModSettings::Smart_Parkour_Enabled = _smartParkour;
-    ModSettings::UseIndicators = _useIndicators;
-
-    ModSettings::ModEnabled = _enableMod;
+    const auto settings = ModSettings::Update([=](ModSettings::Settings &s) {
+        s.UsePresetParkourKey = _usePresetKey;
+        s.Smart_Parkour_Enabled = _smartParkour;
+        s.UseIndicators = _useIndicators;
+        s.ModEnabled = _enableMod;
+    });
+    logger::info(">Settings version {}", ModSettings::published.Version());
 
     // Turn on if setting is on and is not beast form. Same logic on race change listener.
-    Parkouring::SetParkourOnOff(ModSettings::ModEnabled && !ParkourUtility::IsBeastForm());
+    Parkouring::SetParkourOnOff(settings.ModEnabled && !ParkourUtility::IsBeastForm());
 }
 
 bool PapyrusFunctions(RE::BSScript::IVirtualMachine *vm) {
@@ -60,6 +65,8 @@ bool PapyrusFunctions(RE::BSScript::IVirtualMachine *vm) {
 }
 
 void Install_Hooks_And_Listeners() {
+    Scheduler::Install();
+    Scheduler::EveryFrame(Parkouring::SampleFrameTime);
     RaceChangeListener::Register();
     MenuListener::Register();
     //ButtonEventListener::Register();  // Do it inside Menu Listener, when main menu closes
@@ -107,12 +114,14 @@ void MessageEvent(SKSE::MessagingInterface::Message *message) {
         }
 
         RegisterIndicators();
+        ParkourTuning::Load();
         Install_Hooks_And_Listeners();
         RuntimeMethods::SetupModCompatibility();
 
         logger::info(">> SkyParkour Loaded <<");
     }
     else if (message->type == SKSE::MessagingInterface::kPreLoadGame) {
+        Parkouring::LogParkourPointUpdateStats();
         RuntimeMethods::ResetRuntimeVariables();
     }
     else if (message->type == SKSE::MessagingInterface::kPostLoadGame) {
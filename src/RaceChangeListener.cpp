@@ -32,6 +32,9 @@ RE::BSEventNotifyControl RaceChangeListener::ProcessEvent(const RE::TESSwitchRac
     if (actorRef->formID != player->formID)
         return RE::BSEventNotifyControl::kContinue;
 
+    // New race, new skeleton and possibly new height
+    ScaleUtility::InvalidateScale();
+
     // it *is* the player, if it has pre transformation data, then it is a beast race. Unregister button listener to stop parkour
     const auto playerPreTransformData = player->GetPlayerRuntimeData().preTransformationData;
     if (playerPreTransformData) {
@@ -40,7 +43,7 @@ RE::BSEventNotifyControl RaceChangeListener::ProcessEvent(const RE::TESSwitchRac
     }
     else {
         logger::info(">> Exiting Beast Form");
-        if (ModSettings::ModEnabled) {
+        if (ModSettings::Get().ModEnabled) {
             Parkouring::SetParkourOnOff(true);
         }
     }
@@ -1,20 +1,7 @@
 #include "References.h"
 
 namespace ModSettings {
-
-    bool UsePresetParkourKey = true;
-    int PresetParkourKey = 0;  // enum ParkourKeyOptions
-
-    bool ModEnabled = true;
-    bool UseIndicators = true;
-
-    float parkourDelay = 0.0f;  // Set initial delay
-
-    bool Enable_Stamina_Consumption = true;
-    bool Is_Stamina_Required = true;
-    float Stamina_Damage = 20.0f;
-
-    bool Smart_Parkour_Enabled = true;  // Don't use high/failed ledge when moving, don't use vault when standing still
+    ParkourCore::Published<Settings> published;
 }  // namespace ModSettings
 
 /*=========================================================================*/
@@ -30,7 +17,7 @@ void RuntimeMethods::SwapLegs() {
 void RuntimeMethods::ResetRuntimeVariables() {
     RuntimeVariables::ParkourEndQueued = false;
     RuntimeVariables::wasFirstPerson = false;
-    RuntimeVariables::selectedLedgeType = ParkourType::NoLedge;
+    RuntimeVariables::detection.Store({});
 }
 void RuntimeMethods::CheckRequirements() {
     struct Requirements {
@@ -79,64 +66,13 @@ namespace Compatibility {
     //bool ImprovedCamera = false;
 }  // namespace Compatibility
 
-namespace HardCodedVariables {
-    // Lower - upper limits for ledge - vault detection.
-    const float climbMaxHeight = 250.0f;
-    const float climbMinHeight = 20.0f;
-
-    const float vaultMaxHeight = 90.0f;
-    const float vaultMinHeight = 40.5f;
-
-    // These are the height ranges for parkour type selection, represent low limits.
-    const float highestLedgeLimit = 220.0f;
-    const float highLedgeLimit = 170.0f;
-    const float medLedgeLimit = 123.0f;
-    const float lowLedgeLimit = 80.0f;
-    const float highStepLimit = 40.0f;
-
-    // These are the ending heights for each animation, they are dependent on animmotion data.
-    const float highestLedgeElevation = 250.0f;
-    const float highLedgeElevation = 200.0f;
-    const float medLedgeElevation = 153.0f;
-    const float lowLedgeElevation = 110.0f;
-
-    const float stepHighElevation = 70.0f;
-    const float stepLowElevation = 50.0f;
-
-    const float vaultElevation = 60.0f;
-
-    const float grabElevation = 60.0f;
-}  // namespace HardCodedVariables
-
-namespace ParkourType {
-    const int Highest = 8;
-    const int High = 7;
-
-    const int Medium = 6;
-    const int Low = 5;
-    const int StepHigh = 4;
-    const int StepLow = 3;
-
-    const int Vault = 2;
-
-    const int Grab = 1;
-
-    const int Failed = 0;
-
-    const int NoLedge = -1;
-}  // namespace ParkourType
-
 namespace RuntimeVariables {
     bool IsParkourActive = true;
 
-    RE::COL_LAYER lastHitObject;
-
     float PlayerScale = 1.0f;
 
-    int selectedLedgeType = -1;
-    RE::NiPoint3 ledgePoint = {0, 0, 0};
-    RE::NiPoint3 playerDirFlat = {0, 0, 0};
-    RE::NiPoint3 backwardAdjustment = {0, 0, 0};
+    ParkourCore::SeqLock<Detection> detection;
+    ParkourCore::DetectionResult activeParkour;
 
     bool wasFirstPerson = false;
 
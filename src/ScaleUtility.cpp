@@ -85,16 +85,58 @@ namespace ScaleUtility {
         return 1.0;
     }
 
+    namespace {
+        // Resolved once per 3D load, the scales are read from them on every call so SetScale and mods scaling the
+        // bones show up right away. The references keep a dropped model alive until the next call, its address can't
+        // be reused by the next one in between.
+        struct ScaleCache {
+                RE::NiPointer<RE::NiAVObject> model3P;  // Model scale, scaling done by the game (SetScale)
+                RE::NiPointer<RE::NiAVObject> model1P;  // Used when there is no third person model
+                RE::NiPointer<RE::NiAVObject> npc;      // NPC bone, Racemenu uses this
+                RE::NiPointer<RE::NiAVObject> npcRoot;  // Child bone of "NPC", some other mods scale this bone instead
+        };
+
+        ScaleCache scaleCache;
+        std::atomic<bool> scaleCacheDirty{true};
+
+        RE::NiAVObject* FindBoneNodeAnyView(const RE::Actor* a_actor, const std::string_view a_boneName) {
+            if (const auto node = FindBoneNode(a_actor, a_boneName, false)) {
+                return node;
+            }
+            return FindBoneNode(a_actor, a_boneName, true);
+        }
+
+        void ResolveNodes(const RE::Actor* a_actor) {
+            scaleCache.npc = FindBoneNodeAnyView(a_actor, "NPC");
+            scaleCache.npcRoot = FindBoneNodeAnyView(a_actor, "NPC Root [Root]");
+        }
+
+        float ScaleOf(const RE::NiPointer<RE::NiAVObject>& a_node) {
+            return a_node ? a_node->local.scale : 1.0f;
+        }
+    }  // namespace
+
+    void InvalidateScale() {
+        scaleCacheDirty.store(true, std::memory_order_release);
+    }
+
     [[nodiscard]] float GetScale() {
         const auto player = RE::PlayerCharacter::GetSingleton();
         if (!player)
             return false;
 
-        float TargetScale = 1.0f;
-        TargetScale *= GetModelScale(player);                    // Model scale, Scaling done by game
-        TargetScale *= GetNodeScale(player, "NPC");              // NPC bone, Racemenu uses this.
-        TargetScale *= GetNodeScale(player, "NPC Root [Root]");  // Child bone of "NPC" some other mods scale this bone instead
+        // Hot path: two pointer compares and three loads. Bone lookups only after a 3D reload or an invalidation.
+        const auto model3P = player->Get3D(false);
+        const auto model1P = player->Get3D(true);
+        if (scaleCacheDirty.exchange(false, std::memory_order_acq_rel) || model3P != scaleCache.model3P.get() ||
+            model1P != scaleCache.model1P.get()) {
+            scaleCache.model3P.reset(model3P);
+            scaleCache.model1P.reset(model1P);
+            ResolveNodes(player);
+        }
 
+        const auto& model = scaleCache.model3P ? scaleCache.model3P : scaleCache.model1P;
+        float TargetScale = ScaleOf(model) * ScaleOf(scaleCache.npc) * ScaleOf(scaleCache.npcRoot);
         if (TargetScale < 0.15f)
             TargetScale = 0.15f;
         if (TargetScale > 250.f)
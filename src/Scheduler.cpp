@@ -0,0 +1,45 @@
+#include "Scheduler.h"
+#include "ParkourUtility.h"
+
+using ParkourUtility::SteadyNowMs;
+
+namespace {
+    ParkourCore::TimerWheel wheel{SteadyNowMs()};
+    std::vector<Scheduler::FrameCallback> frameCallbacks;
+
+    // Call in Main::Update that runs once per frame, in menus and loading screens too
+    struct MainUpdateHook {
+            static void hook() {
+                orig();
+                wheel.Advance(SteadyNowMs());
+                for (const auto callback: frameCallbacks) {
+                    callback();
+                }
+            }
+
+            static inline REL::Relocation<decltype(hook)> orig;
+            static inline REL::RelocationID srcFunc{35565, 36564};
+            static inline std::uintptr_t srcFuncOffset = REL::Relocate(0x748, 0xC26);
+            static constexpr auto logName = "Main Update";
+    };
+}  // namespace
+
+void Scheduler::Install() {
+    Hooking::writeCall<MainUpdateHook>();
+}
+
+Scheduler::Handle Scheduler::AfterMs(std::uint32_t delayMs, Callback callback) {
+    return wheel.AfterMs(SteadyNowMs(), delayMs, std::move(callback));
+}
+
+Scheduler::Handle Scheduler::AfterFrames(std::uint32_t frames, Callback callback) {
+    return wheel.AfterFrames(frames, std::move(callback));
+}
+
+bool Scheduler::Cancel(Handle handle) {
+    return wheel.Cancel(handle);
+}
+
+void Scheduler::EveryFrame(FrameCallback callback) {
+    frameCallbacks.push_back(callback);
+}